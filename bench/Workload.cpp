@@ -0,0 +1,76 @@
+//Synthetic catalogs and user populations for the benchmarks
+#include "Workload.h"
+#include "helpers.h"
+#include <fstream>
+#include <array>
+
+WorkloadGenerator::WorkloadGenerator(const vector<Exercise>& realExercises, const ExerciseStore& store, uint64_t seed)
+    : rng(seed) {
+    for (const Exercise& ex : realExercises) {
+        ExerciseView view(ex, store);
+        muscleSets.push_back(view.muscleGroups());
+        equipmentTexts.push_back(string(view.equipment()));
+    }
+}
+
+//muscles and equipment are drawn from different real exercises so the catalog gets new combinations
+//but each field keeps the distribution it has in the database
+bool WorkloadGenerator::writeCatalog(const string& filename, size_t count) {
+    ofstream out(filename, ios::trunc);
+    if (!out.is_open() || muscleSets.empty()) return false;
+
+    uniform_int_distribution<size_t> pick(0, muscleSets.size() - 1);
+    out << "[\n";
+    for (size_t i = 0; i < count; i++) {
+        const vector<string>& muscles = muscleSets[pick(rng)];
+        const string& equipment = equipmentTexts[pick(rng)];
+
+        out << "{\"exercise\":\"Exercise " << i << "\",\"muscle_groups\":[";
+        for (size_t m = 0; m < muscles.size(); m++) {
+            if (m) out << ",";
+            out << json(muscles[m]).dump();
+        }
+        out << "],\"equipment\":" << json(equipment).dump() << "}";
+        out << (i + 1 < count ? ",\n" : "\n");
+    }
+    out << "]\n";
+    return (bool)out;
+}
+
+vector<User> WorkloadGenerator::makeUsers(size_t count) {
+    static const vector<string> uiMuscles = {"Chest", "Back", "Shoulders", "Arms", "Legs", "Glutes", "Core", "Cardio"};
+    static const vector<Goal> goals = {Goal::ENDURANCE, Goal::LIGHT_BUILD, Goal::MUSCLE_BUILD,
+                                       Goal::STRENGTH_BUILD, Goal::STRENGTH};
+    vector<string> categories = getCategoryNames();
+
+    vector<User> users;
+    users.reserve(count);
+    uniform_int_distribution<int> coin(0, 1);
+    uniform_int_distribution<int> level(0, 2);
+    uniform_int_distribution<int> dayCount(1, 7);
+    uniform_int_distribution<size_t> goal(0, goals.size() - 1);
+
+    for (size_t i = 0; i < count; i++) {
+        //a random set of days
+        array<int, DAYS_IN_WEEK> order = {MONDAY, TUESDAY, WEDNESDAY, THURSDAY, FRIDAY, SATURDAY, SUNDAY};
+        shuffle(order.begin(), order.end(), rng);
+        DayMask days = 0;
+        for (int d = dayCount(rng); d > 0; d--) days |= dayBit(order[d - 1]);
+
+        unordered_set<string> equipment;
+        for (const string& category : categories) {
+            if (coin(rng)) equipment.insert(category);
+        }
+        if (equipment.empty()) equipment.insert("Bodyweight");
+
+        map<string, Priority> priorities;
+        for (const string& muscle : uiMuscles) {
+            priorities[muscle] = (Priority)level(rng);
+        }
+
+        users.emplace_back("User " + to_string(i), 150 + (int)(rng() % 50), 45 + (int)(rng() % 60),
+                           18 + (int)(rng() % 50), coin(rng) ? "Male" : "Female", days,
+                           move(equipment), move(priorities), goals[goal(rng)]);
+    }
+    return users;
+}
@@ -0,0 +1,31 @@
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#include "Exercise.h"
+#include "User.h"
+#include <string>
+#include <vector>
+#include <random>
+#include <cstdint>
+
+using namespace std;
+
+//Makes synthetic catalogs and users for the benchmarks. Everything comes from one seed so
+//two runs with the same seed time exactly the same work.
+class WorkloadGenerator {
+private:
+    vector<vector<string>> muscleSets;   //muscle groups of each real exercise
+    vector<string> equipmentTexts;       //equipment field of each real exercise
+    mt19937_64 rng;
+
+public:
+    //samples from the real exercises so the muscle and equipment mix matches the database
+    WorkloadGenerator(const vector<Exercise>& realExercises, const ExerciseStore& store, uint64_t seed);
+
+    //writes a catalog JSON with count exercises, streamed so a million entries don't need a DOM
+    bool writeCatalog(const string& filename, size_t count);
+
+    vector<User> makeUsers(size_t count);
+};
+
+#endif
@@ -0,0 +1,189 @@
+//Benchmarks for the planner on synthetic catalogs from 100 to 1,000,000 exercises.
+//  benchmark [--database exercise_database.json] [--sizes 100,1000,10000] [--users 200] [--seed 42]
+//Reports throughput, min/p50/p99 latency and heap allocations per call for each stage.
+//Every stage runs several times, loadData after a couple of untimed warm-up loads.
+#include "WorkoutPlanner.h"
+#include "Workload.h"
+#include "helpers.h"
+#include "PlanSerializer.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <new>
+#include <sstream>
+
+//counts every heap allocation in the process so we can report allocations per plan
+static atomic<uint64_t> allocationCount{0};
+
+void* operator new(size_t size) {
+    allocationCount.fetch_add(1, memory_order_relaxed);
+    if (void* ptr = malloc(size ? size : 1)) return ptr;
+    throw bad_alloc();
+}
+void operator delete(void* ptr) noexcept { free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { free(ptr); }
+
+using Clock = chrono::steady_clock;
+
+//untimed loads before the timed ones, so the file is in the page cache and the allocator is warm
+static constexpr int LOAD_WARMUPS = 2;
+
+//timings of one stage, in microseconds per call
+class StageTimer {
+private:
+    string name;
+    vector<double> micros;
+    uint64_t allocations = 0;
+
+public:
+    explicit StageTimer(string stageName) : name(move(stageName)) {}
+
+    template <class Work>
+    void run(Work&& work) {
+        uint64_t allocsBefore = allocationCount.load(memory_order_relaxed);
+        auto start = Clock::now();
+        work();
+        auto end = Clock::now();
+        allocations += allocationCount.load(memory_order_relaxed) - allocsBefore;
+        micros.push_back(chrono::duration<double, micro>(end - start).count());
+    }
+
+    void report() {
+        if (micros.empty()) return;
+        double total = 0;
+        for (double m : micros) total += m;
+        sort(micros.begin(), micros.end());
+        auto percentile = [this](double p) {
+            return micros[min(micros.size() - 1, (size_t)(p * micros.size()))];
+        };
+        printf("  %-16s %8zu calls %12.1f ops/s  min %10.1f us  p50 %10.1f us  p99 %10.1f us  %10.1f allocs/op\n",
+               name.c_str(), micros.size(), micros.size() / (total / 1e6), micros.front(), percentile(0.50),
+               percentile(0.99), (double)allocations / micros.size());
+    }
+};
+
+//swallows cout while the planner runs so printing doesn't end up in the timings
+class QuietCout {
+private:
+    streambuf* saved;
+    ostringstream sink;
+
+public:
+    QuietCout() : saved(cout.rdbuf(sink.rdbuf())) {}
+    ~QuietCout() { cout.rdbuf(saved); }
+    void clear() { sink.str(""); }
+};
+
+static vector<size_t> parseSizes(const string& text) {
+    vector<size_t> sizes;
+    stringstream ss(text);
+    string item;
+    while (getline(ss, item, ',')) {
+        sizes.push_back(stoull(item));
+    }
+    return sizes;
+}
+
+int main(int argc, char* argv[]) {
+    string database = "exercise_database.json";
+    vector<size_t> sizes = {100, 1000, 10000, 100000, 1000000};
+    size_t userCount = 200;
+    uint64_t seed = 42;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        string flag = argv[i];
+        if (flag == "--database") database = argv[i + 1];
+        else if (flag == "--sizes") sizes = parseSizes(argv[i + 1]);
+        else if (flag == "--users") userCount = stoull(argv[i + 1]);
+        else if (flag == "--seed") seed = stoull(argv[i + 1]);
+        else {
+            fprintf(stderr, "Unknown option %s\n", flag.c_str());
+            return 1;
+        }
+    }
+
+    EquipmentVocab vocab;
+    ExerciseStore store;
+    vector<Exercise> real = loadDatabase(database, vocab, store);
+    if (real.empty()) {
+        fprintf(stderr, "Failed to load %s\n", database.c_str());
+        return 1;
+    }
+
+    WorkloadGenerator generator(real, store, seed);
+    vector<User> users = generator.makeUsers(userCount);
+    string catalogFile = (filesystem::temp_directory_path() / "swp_bench_catalog.json").string();
+
+    for (size_t size : sizes) {
+        printf("\nCatalog of %zu exercises\n", size);
+        if (!generator.writeCatalog(catalogFile, size)) {
+            fprintf(stderr, "Failed to write %s\n", catalogFile.c_str());
+            return 1;
+        }
+
+        //fewer users and loads on big catalogs so every size finishes in about the same time
+        size_t runs = min(users.size(), max<size_t>(20, 20000000 / size));
+        size_t loads = clamp<size_t>(2000000 / size, 3, 20);
+
+        WorkoutPlanner planner;
+        StageTimer load("loadData");
+        StageTimer equipment("filterEquipment");
+        StageTimer muscles("filterMuscles");
+        StageTimer scan("filterExercises");
+        StageTimer plan("makePlan");
+        StageTimer day("makeDay");
+        StageTimer show("showPlan");
+        StageTimer serialize("writePlanJson");
+        string buffer;
+
+        {
+            QuietCout quiet;
+            for (int warm = 0; warm < LOAD_WARMUPS; warm++) {
+                planner.loadData(catalogFile);
+            }
+            //a fresh planner for every timed load, so freeing the catalog before isn't timed with it
+            for (size_t i = 0; i < loads; i++) {
+                WorkoutPlanner fresh;
+                load.run([&] { fresh.loadData(catalogFile); });
+                quiet.clear();
+            }
+
+            vector<uint32_t> everything(planner.getCatalog()->size());
+            for (uint32_t i = 0; i < everything.size(); i++) everything[i] = i;
+
+            for (size_t u = 0; u < runs; u++) {
+                PlanContext ctx(users[u]);
+                ctx.rng.seed(seed + u);
+
+                equipment.run([&] { planner.filterEquipment(ctx); });
+                vector<string> targets = users[u].getHighMuscles();
+                muscles.run([&] { planner.filterMuscles(everything, targets); });
+                scan.run([&] { planner.filterExercises(ctx, muscleMaskOf(targets)); });
+
+                vector<WorkoutSession> result;
+                plan.run([&] { result = planner.makePlan(ctx); });
+                day.run([&] { planner.makeDay(ctx); });
+                show.run([&] { planner.showPlan(result); });
+                serialize.run([&] {
+                    buffer.clear();
+                    writePlanJson(result, buffer);
+                });
+                quiet.clear();
+            }
+        }
+
+        load.report();
+        equipment.report();
+        muscles.report();
+        scan.report();
+        plan.report();
+        day.report();
+        show.report();
+        serialize.report();
+    }
+
+    filesystem::remove(catalogFile);
+    return 0;
+}
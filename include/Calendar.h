@@ -0,0 +1,91 @@
+#ifndef CALENDAR_H
+#define CALENDAR_H
+
+#include <string>
+#include <vector>
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+using namespace std;
+
+//Days of the week as small ids, names are only used when reading input and printing
+enum Weekday {
+    MONDAY,
+    TUESDAY,
+    WEDNESDAY,
+    THURSDAY,
+    FRIDAY,
+    SATURDAY,
+    SUNDAY,
+    DAYS_IN_WEEK
+};
+
+//one bit per weekday, Monday is bit 0
+using DayMask = uint8_t;
+
+constexpr DayMask dayBit(int day) {
+    return DayMask(1) << day;
+}
+
+constexpr DayMask ALL_DAYS = (1 << DAYS_IN_WEEK) - 1;
+
+//-1 for names that aren't a weekday
+int weekdayId(const string& name);
+const string& weekdayName(int day);
+DayMask dayMaskOf(const vector<string>& names);
+//training days in week order
+vector<Weekday> daysOf(DayMask days);
+
+//Tables for every possible set of training days, filled in once. The week wraps, so for
+//Monday the previous training day can be the Sunday before.
+struct WeekTables {
+    //previous training day before each day, DAYS_IN_WEEK if there are no training days
+    array<array<uint8_t, DAYS_IN_WEEK>, 128> previous;
+    //days since that previous training day, 1 when it was yesterday and 7 for the same day a week ago
+    array<array<uint8_t, DAYS_IN_WEEK>, 128> restGap;
+    //days until the next training day, 0 when the day itself is one
+    array<array<uint8_t, DAYS_IN_WEEK>, 128> nextGap;
+};
+const WeekTables& weekTables();
+
+inline int previousTrainingDay(DayMask days, int day) {
+    return weekTables().previous[days & ALL_DAYS][day];
+}
+inline int restGap(DayMask days, int day) {
+    return weekTables().restGap[days & ALL_DAYS][day];
+}
+inline int nextGap(DayMask days, int day) {
+    return weekTables().nextGap[days & ALL_DAYS][day];
+}
+//training days directly after another training day in the same week
+inline DayMask backToBackDays(DayMask days) {
+    return days & DayMask(days << 1);
+}
+
+Weekday weekdayOf(chrono::sys_days date);
+
+//Training days on real dates, either fixed weekdays or every few days from a start date.
+//Finding the training day before or after a date is a constant amount of work either way.
+class TrainingSchedule {
+private:
+    DayMask weekdays = 0;
+    int interval = 0;          //0 for a weekly schedule
+    chrono::sys_days start{};
+
+public:
+    static TrainingSchedule weekly(DayMask days);
+    static TrainingSchedule everyNDays(int days, chrono::sys_days firstDay);
+
+    bool trainsOn(chrono::sys_days date) const;
+    //last training day before date, date itself if there is none
+    chrono::sys_days previous(chrono::sys_days date) const;
+    //first training day on or after date
+    chrono::sys_days next(chrono::sys_days date) const;
+    //training days in [from, to)
+    vector<chrono::sys_days> between(chrono::sys_days from, chrono::sys_days to) const;
+    //training days of the Monday to Sunday week that date is in
+    DayMask weekOf(chrono::sys_days date) const;
+};
+
+#endif
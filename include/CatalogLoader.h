@@ -0,0 +1,25 @@
+#ifndef CATALOGLOADER_H
+#define CATALOGLOADER_H
+
+#include "Exercise.h"
+#include "Equipment.h"
+#include "ExerciseCatalog.h"
+#include <istream>
+#include <string>
+#include <memory>
+#include <functional>
+
+using namespace std;
+
+//Reads the top level array of a JSON catalog with a SAX parser and calls onExercise as soon as
+//each element is complete, so memory stays around one exercise no matter how big the file is.
+//Entries missing "exercise", "muscle_groups" or "equipment" are skipped with a warning.
+//Returns false if the input is not a JSON array or has a syntax error.
+bool streamExercises(istream& input, EquipmentVocab& vocab, ExerciseStore& store,
+                     const function<void(Exercise&&)>& onExercise);
+
+//Maps the file and splits the top level array into chunks that are parsed on several threads,
+//0 threads uses one per core. Exercises keep the order they have in the file.
+shared_ptr<const ExerciseCatalog> loadCatalogParallel(const string& filename, size_t threads = 0);
+
+#endif
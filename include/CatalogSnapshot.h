@@ -0,0 +1,56 @@
+#ifndef CATALOGSNAPSHOT_H
+#define CATALOGSNAPSHOT_H
+
+#include "ExerciseCatalog.h"
+#include <string>
+#include <memory>
+#include <cstdint>
+
+using namespace std;
+
+//Binary copy of a compiled catalog so workers don't have to parse the JSON on every start.
+//Layout, 8 byte aligned:
+//  header | muscle names | equipment names | name pool | records | equipment options | text
+//The records, options and text are the catalog's Exercise array and ExerciseStore as they are in
+//memory, so the loader points the catalog at the mapped file instead of copying them. That makes
+//the file specific to the byte order and Exercise layout it was written with, the loader rejects
+//a file from a machine where either differs and it has to be compiled again there.
+//Muscle and equipment names are offset/length pairs into the name pool, stored in id order so the
+//masks in the records can be used as they are.
+constexpr char SNAPSHOT_MAGIC[8] = {'S', 'W', 'P', 'C', 'A', 'T', '\0', '\0'};
+constexpr uint32_t SNAPSHOT_VERSION = 2;
+constexpr uint32_t SNAPSHOT_BYTE_ORDER = 0x01020304;   //reads back differently on the other byte order
+
+struct SnapshotString {
+    uint32_t offset;
+    uint32_t length;
+};
+
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint32_t recordSize;       //sizeof(Exercise) of the writer
+    uint32_t exerciseCount;
+    uint32_t muscleCount;
+    uint32_t equipmentCount;
+    uint32_t optionCount;
+    uint32_t padding;
+    uint64_t namePoolSize;
+    uint64_t textSize;
+    uint64_t muscleOffset;
+    uint64_t equipmentOffset;
+    uint64_t namePoolOffset;
+    uint64_t recordOffset;
+    uint64_t optionOffset;
+    uint64_t textOffset;
+};
+
+bool isSnapshot(const string& filename);
+bool saveSnapshot(const ExerciseCatalog& catalog, const string& filename);
+
+//Maps the file and keeps it mapped for as long as the catalog lives, the records and text are
+//read where they are. nullptr if the file is invalid.
+shared_ptr<const ExerciseCatalog> loadSnapshot(const string& filename);
+
+#endif
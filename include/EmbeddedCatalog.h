@@ -0,0 +1,40 @@
+#ifndef EMBEDDEDCATALOG_H
+#define EMBEDDEDCATALOG_H
+
+#include "ExerciseCatalog.h"
+#include "Equipment.h"
+#include "Muscle.h"
+#include <string>
+#include <memory>
+#include <cstdint>
+
+using namespace std;
+
+//One row of the catalog compiled into the binary. The tables are generated from the JSON with
+//  planner --embed-catalog exercise_database.json src/EmbeddedCatalogData.inc
+//and only built in when compiling with -DSWP_EMBEDDED_CATALOG.
+//The text refs are offsets into the embedded string pool, laid out the way ExerciseStore keeps its
+//text, so the rows become Exercise records without copying or parsing anything.
+struct EmbeddedExercise {
+    uint32_t nameRef;
+    uint32_t equipmentRef;
+    uint32_t categoryRef;
+    uint32_t firstOption;    //into the equipment option table
+    MuscleMask muscleMask;   //Arms and Legs already expanded
+    uint32_t firstMuscle;    //into the muscle id table, in the order of the JSON
+    uint8_t muscleCount;
+    uint8_t optionCount;
+    uint8_t duration;
+    bool compound;
+};
+
+//true when the binary was built with the catalog inside it
+bool hasEmbeddedCatalog();
+
+//catalog built from the compiled in tables on first use, nullptr without SWP_EMBEDDED_CATALOG
+shared_ptr<const ExerciseCatalog> embeddedCatalog();
+
+//writes the constexpr tables for a catalog, only the known muscle groups can be embedded
+bool writeEmbeddedCatalog(const ExerciseCatalog& catalog, const string& filename);
+
+#endif
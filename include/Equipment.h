@@ -0,0 +1,62 @@
+#ifndef EQUIPMENT_H
+#define EQUIPMENT_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+
+using namespace std;
+
+//one bit per interned equipment item
+using EquipmentMask = uint64_t;
+
+//Requirement parsed from the "equipment" field of the database.
+//"+" means all of and "/" or "or" means any of, so "Barbell / Dumbbells + Bench" becomes
+//(Barbell AND Bench) OR (Dumbbells AND Bench). Each option is a mask of items that are all needed.
+struct EquipmentReq {
+    vector<EquipmentMask> options;
+
+    bool satisfiedBy(EquipmentMask owned) const {
+        for (EquipmentMask option : options) {
+            if ((owned & option) == option) return true;
+        }
+        return false;
+    }
+};
+
+//Gives every equipment name a small id so the planner can compare masks instead of strings.
+//Names are matched case insensitive and without plural s, and a name also matches when it is a
+//whole word suffix of the other one (so "Machine" covers "Cable Row Machine" and "EZ Bar" covers "Bar").
+class EquipmentVocab {
+private:
+    vector<string> names;             //normalized name by id
+    unordered_map<string, int> ids;
+    bool overflow = false;            //an item was turned away because every bit was taken
+
+public:
+    static constexpr int BODYWEIGHT = 0;    //everyone owns bodyweight
+    static constexpr int MAX_BITS = 64;     //distinct items one vocab can hold, one bit each
+
+    EquipmentVocab();
+
+    //-1 when the item is new and all MAX_BITS ids are taken, the loaders turn that into an error
+    //instead of letting two items share a bit
+    int intern(const string& name);
+    EquipmentReq parse(const string& text);
+    bool overflowed() const;
+
+    //owned should already have the categories expanded
+    EquipmentMask ownedMask(const unordered_set<string>& owned) const;
+    //ids matching one owned item, ownedMask is these or'ed together plus bodyweight
+    EquipmentMask itemMask(const string& item) const;
+
+    //id has to be a valid id, below MAX_BITS
+    static EquipmentMask bit(int id);
+    static string normalize(const string& name);
+    size_t size() const;
+    const string& name(int id) const;
+};
+
+#endif
@@ -1,35 +1,76 @@
 #ifndef EXERCISE_H
 #define EXERCISE_H
 #include <string>
+#include <string_view>
 #include <vector>
+#include <array>
+#include <span>
 #include <iostream>
+#include <cstdint>
 #include "json.hpp"
+#include "Equipment.h"
+#include "Muscle.h"
+#include "ExerciseStore.h"
 
 using namespace std;
 using json=nlohmann::json;
 
+//One exercise as a fixed size record. The text and equipment options are references into the
+//ExerciseStore it was made with, so copies are a plain 32 byte copy. Read the text through an ExerciseView.
 class Exercise {
 public:
-    string name;
-    vector<string> muscleGroups;
-    string equipment;
-    string equipmentCategory;
+    //muscles past this many are still in muscleMask, they just aren't listed by name
+    static constexpr int MAX_LISTED_MUSCLES = 6;
+
+    uint32_t nameRef = 0;
+    uint32_t equipmentRef = 0;
+    uint32_t categoryRef = 0;
+    uint32_t firstOption = 0;     //equipment text parsed into item ids, options in the store
+    MuscleMask muscleMask = 0;    //Arms and Legs already expanded
+
+    //estimated time the workout will take to complete, factors like set up time and so are included.
+    uint16_t estimatedDurationMinutes = 5;
+    uint16_t optionCount = 0;
+    uint8_t muscleCount = 0;
+    array<uint8_t, MAX_LISTED_MUSCLES> muscleIds{};   //muscle groups in the order of the database
 
     //edge case in case a user selects only one avaliability day and high priority for all muscle groups.
     //system would select the most commpound exercises like squats and assign it to the schedule.
-    bool isCompound;
+    bool isCompound = false;
 
-    //estimated time the workout will take to complete, factors like set up time and so are included.
-    int estimatedDurationMinutes;
-    Exercise(string n, vector<string> muscles, string equip, bool compound = false, int duration = 5);
-    void display() const;
+    Exercise() = default;
+    Exercise(ExerciseStore& store, string_view n, const vector<string>& muscles, string_view equip,
+             bool compound = false, int duration = 5);
+
+    span<const uint8_t> listedMuscles() const { return span<const uint8_t>(muscleIds.data(), muscleCount); }
 
     bool targetsAnyMuscle(const vector<string>& targetMuscles) const;
+    bool targetsAnyMuscle(MuscleMask targets) const { return (muscleMask & targets) != 0; }
+
+    static Exercise from_json(const json& j, EquipmentVocab& vocab, ExerciseStore& store);
+};
+
+//An exercise together with the store holding its text, only valid while both are alive
+class ExerciseView {
+private:
+    const Exercise* record;
+    const ExerciseStore* store;
+
+public:
+    ExerciseView(const Exercise& ex, const ExerciseStore& exerciseStore) : record(&ex), store(&exerciseStore) {}
+
+    const Exercise& get() const { return *record; }
+    string_view name() const { return store->text(record->nameRef); }
+    string_view equipment() const { return store->text(record->equipmentRef); }
+    string_view equipmentCategory() const { return store->text(record->categoryRef); }
+    vector<string> muscleGroups() const;
+    span<const EquipmentMask> equipmentOptions() const { return store->options(record->firstOption, record->optionCount); }
+
+    void display() const;
 
     //checks if the workout needs any equipment. Like pushups dont need any so it would return false.
     bool requiresEquipment(const string& equip) const;
 
-    static Exercise from_json(const json& j);
     json to_json() const;
 };
 
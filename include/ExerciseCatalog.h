@@ -0,0 +1,95 @@
+#ifndef EXERCISECATALOG_H
+#define EXERCISECATALOG_H
+
+#include "Exercise.h"
+#include "Equipment.h"
+#include "Muscle.h"
+#include "Postings.h"
+#include "ExerciseTable.h"
+#include <vector>
+#include <string>
+#include <memory>
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+using namespace std;
+
+//Exercises one set of equipment can do, as sorted catalog indices
+struct EligiblePool {
+    EquipmentMask owned;
+    vector<uint32_t> exercises;
+    vector<uint32_t> compounds;
+    array<vector<uint32_t>, MAX_MUSCLES> byMuscle;
+};
+
+//The loaded exercise database. It never changes after loading so one catalog can be shared
+//by every planner and thread through a shared_ptr.
+class ExerciseCatalog {
+private:
+    vector<Exercise> ownedExercises;   //empty when the records are read in place, like from a snapshot
+    span<const Exercise> exercises;
+    ExerciseStore store;   //text and equipment options the exercises point into
+    shared_ptr<const void> backing;   //keeps records and text that aren't owned alive, like a mapped file
+    EquipmentVocab equipmentVocab;
+    ExerciseTable table;   //same exercises by column, for full scans
+
+    //Posting lists built once at load time. Equipment is indexed by each option of the
+    //requirement, an option with one item is the list for that equipment id.
+    array<PostingList, MAX_MUSCLES> muscleIndex;
+    vector<pair<EquipmentMask, PostingList>> equipmentIndex;
+    PostingList compoundIndex;
+
+    void buildIndexes();
+
+    //Pools shared by every user with the same equipment. Open addressing on the mask, slots are
+    //only ever filled once so a hit is a few atomic loads without any lock. A new catalog
+    //starts with an empty table, so reloading is what invalidates it.
+    static constexpr size_t POOL_SLOTS = 512;
+    mutable array<atomic<EligiblePool*>, POOL_SLOTS> pools{};
+
+public:
+    ExerciseCatalog(vector<Exercise> exs, EquipmentVocab vocab, ExerciseStore exerciseStore,
+                    shared_ptr<const void> owner = nullptr);
+    //uses the records where they are, owner keeps them and the store's memory alive
+    ExerciseCatalog(span<const Exercise> records, EquipmentVocab vocab, ExerciseStore exerciseStore,
+                    shared_ptr<const void> owner);
+    ~ExerciseCatalog();
+
+    ExerciseCatalog(const ExerciseCatalog&) = delete;
+    ExerciseCatalog& operator=(const ExerciseCatalog&) = delete;
+
+    //returns nullptr if the file could not be opened or parsed
+    static shared_ptr<const ExerciseCatalog> load(const string& filename);
+
+    span<const Exercise> getExercises() const;
+    const Exercise& get(size_t index) const;
+    //the exercise with its name, equipment text and muscle names
+    ExerciseView view(size_t index) const;
+    const ExerciseStore& getStore() const;
+    const EquipmentVocab& getEquipmentVocab() const;
+    const ExerciseTable& getTable() const;
+
+    //exercises for one muscle id, or for any muscle in the mask
+    const PostingList& muscleExercises(int muscle) const;
+    PostingList muscleExercises(MuscleMask muscles) const;
+    //exercises the owned equipment allows
+    PostingList equipmentExercises(EquipmentMask owned) const;
+    const PostingList& compoundExercises() const;
+
+    //Exercises for any of the muscles (all of them when muscles is 0) that the equipment allows,
+    //only compounds if asked. Answered from the posting lists without touching the exercises.
+    PostingList query(MuscleMask muscles, EquipmentMask owned, bool compoundOnly = false) const;
+
+    //scans the catalog for everything the owned equipment allows
+    unique_ptr<EligiblePool> buildPool(EquipmentMask owned) const;
+
+    //Cached pool for the equipment, built on the first request. The pool lives as long as the catalog.
+    //If the table is full the pool is built for this call only and kept alive by storage.
+    const EligiblePool& eligiblePool(EquipmentMask owned, shared_ptr<const EligiblePool>& storage) const;
+
+    size_t size() const;
+    bool empty() const;
+};
+
+#endif
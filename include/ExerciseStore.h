@@ -0,0 +1,59 @@
+#ifndef EXERCISESTORE_H
+#define EXERCISESTORE_H
+
+#include "Equipment.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <span>
+#include <unordered_map>
+#include <cstdint>
+
+using namespace std;
+
+class Exercise;
+
+//Text and equipment options of the exercises of one catalog, so an Exercise is a fixed size record
+//of 32 bit references instead of owning strings and vectors. Repeated strings like equipment names
+//and categories are stored once. Reference 0 is the empty string.
+class ExerciseStore {
+private:
+    string chars;                         //each string is its length as 4 bytes followed by the text
+    vector<EquipmentMask> optionList;
+    unordered_multimap<size_t, uint32_t> lookup;   //hash of the text -> reference, only while adding
+
+    //set instead of chars and optionList when the store reads memory it doesn't own
+    string_view borrowedChars;
+    span<const EquipmentMask> borrowedOptions;
+
+public:
+    ExerciseStore();
+
+    //Read only store over text and options laid out like textData() and allOptions() of another
+    //store, for example straight from a mapped snapshot. The memory has to outlive the store.
+    static ExerciseStore borrow(string_view textData, span<const EquipmentMask> options);
+
+    uint32_t addText(string_view text);
+    string_view text(uint32_t ref) const;
+    //true if a string starts at ref and fits in the text, for checking references read from a file
+    bool validText(uint32_t ref) const;
+
+    uint32_t addOptions(span<const EquipmentMask> options);
+    span<const EquipmentMask> options(uint32_t first, uint32_t count) const;
+    //for fixing up options while loading, a borrowed store has nothing to change
+    span<EquipmentMask> options(uint32_t first, uint32_t count);
+
+    //everything the references point into, what a snapshot writes out
+    string_view textData() const;
+    span<const EquipmentMask> allOptions() const;
+
+    //same exercise with its text and options copied over from another store
+    Exercise import(const Exercise& ex, const ExerciseStore& from);
+
+    //drops the lookup for sharing strings and spare capacity, for a store that is done growing.
+    //Text added after this is just not shared anymore.
+    void seal();
+    size_t bytes() const;
+};
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef EXERCISETABLE_H
+#define EXERCISETABLE_H
+
+#include "Exercise.h"
+#include "Equipment.h"
+#include "Muscle.h"
+#include <vector>
+#include <string>
+#include <string_view>
+#include <span>
+#include <cstdint>
+
+using namespace std;
+
+//What a table scan keeps. Everything set has to match.
+struct TableFilter {
+    EquipmentMask owned = ~EquipmentMask(0);
+    MuscleMask muscles = 0;                       //0 keeps every muscle
+    bool compoundOnly = false;
+    span<const uint32_t> exclude;                 //sorted indices to leave out, like the ones at the repeat limit
+};
+
+//The catalog stored column by column, so a scan over every exercise reads a few packed arrays
+//instead of jumping between the strings and vectors of each Exercise.
+class ExerciseTable {
+private:
+    vector<MuscleMask> muscleColumn;
+    vector<EquipmentMask> equipmentColumn;   //the requirement when it only has one option
+    vector<uint8_t> flagColumn;
+    vector<int32_t> durationColumn;
+
+    //every option of every requirement, only read for rows flagged MULTI_OPTION
+    vector<uint32_t> optionOffsets;
+    vector<EquipmentMask> options;
+
+    bool optionsSatisfied(size_t row, EquipmentMask owned) const;
+    bool rowMatches(size_t row, const TableFilter& filter) const;
+    void scanScalar(const TableFilter& filter, size_t begin, size_t end, vector<uint32_t>& selection) const;
+#ifdef __AVX2__
+    void scanAvx2(const TableFilter& filter, vector<uint32_t>& selection) const;
+#endif
+
+public:
+    static constexpr uint8_t COMPOUND = 1;
+    static constexpr uint8_t MULTI_OPTION = 2;   //requirement with zero or several options
+
+    ExerciseTable() = default;
+    ExerciseTable(span<const Exercise> exercises, const ExerciseStore& store);
+
+    size_t size() const;
+    MuscleMask muscles(size_t row) const;
+    bool canDo(size_t row, EquipmentMask owned) const;
+    bool isCompound(size_t row) const;
+    int duration(size_t row) const;
+
+    //Selection vector of the rows passing the filter, in row order. Uses AVX2 when the build has it.
+    vector<uint32_t> scan(const TableFilter& filter) const;
+};
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef FATIGUE_H
+#define FATIGUE_H
+
+#include "Muscle.h"
+#include "Calendar.h"
+#include <array>
+#include <cstdint>
+
+using namespace std;
+
+//Which muscles are still recovering on each day of the week. Every training day keeps the
+//muscles it worked, this week and the week before, and they stay fatigued for their recovery
+//window after that (72h for the lower body, 48h for the rest). fatigued(day) walks back over
+//the previous training days with the rest gap tables in Calendar.h, so checking an exercise is
+//then a single compare of its muscle mask against it.
+class FatigueState {
+private:
+    array<MuscleMask, DAYS_IN_WEEK> thisWeek{};
+    array<MuscleMask, DAYS_IN_WEEK> lastWeek{};
+    DayMask thisWeekDays = 0;   //days that trained something, for the gap lookups
+    DayMask lastWeekDays = 0;
+
+public:
+    static int recoveryHours(int muscle);
+    //muscles still recovering that many days after they were trained
+    static MuscleMask recoveringAfter(int days);
+
+    void train(Weekday day, MuscleMask muscles);
+    //drops what was trained that day, for a session that gets replaced
+    void forget(Weekday day);
+    //this week becomes the week before
+    void nextWeek();
+    void clear();
+
+    //muscles trained recently enough before that day to still be recovering
+    MuscleMask fatigued(Weekday day) const;
+    MuscleMask trainedOn(Weekday day) const;
+};
+
+#endif
@@ -0,0 +1,31 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+using namespace std;
+
+//Read only view of a whole file. Uses mmap where we have it so the pages come straight from
+//the page cache, otherwise falls back to reading the file into memory.
+class MappedFile {
+private:
+    const char* bytes = nullptr;
+    size_t length = 0;
+    vector<char> buffer;
+    bool mapped = false;
+
+public:
+    explicit MappedFile(const string& filename);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    //nullptr if the file could not be opened or is empty
+    const char* data() const { return bytes; }
+    size_t size() const { return length; }
+};
+
+#endif
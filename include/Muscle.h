@@ -0,0 +1,114 @@
+#ifndef MUSCLE_H
+#define MUSCLE_H
+
+#include <string>
+#include <vector>
+#include <array>
+#include <iterator>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+using namespace std;
+
+//one bit per muscle group
+using MuscleMask = uint32_t;
+
+constexpr int MAX_MUSCLES = 32;
+
+//Muscle groups used in the exercise database. Arms and Legs are the UI names, they never get set on
+//an exercise directly and expand to Biceps/Triceps and Quads/Hamstrings instead.
+//Names that are not in this list get the next free id when a catalog that uses them is loaded.
+enum MuscleId {
+    MUSCLE_CHEST,
+    MUSCLE_BACK,
+    MUSCLE_SHOULDERS,
+    MUSCLE_BICEPS,
+    MUSCLE_TRICEPS,
+    MUSCLE_QUADS,
+    MUSCLE_HAMSTRINGS,
+    MUSCLE_GLUTES,
+    MUSCLE_CALVES,
+    MUSCLE_CORE,
+    MUSCLE_CARDIO,
+    MUSCLE_FULL_BODY,
+    MUSCLE_HIP_FLEXORS,
+    MUSCLE_OBLIQUES,
+    MUSCLE_ARMS,
+    MUSCLE_LEGS,
+    KNOWN_MUSCLES
+};
+
+constexpr MuscleMask muscleBit(int id) {
+    return MuscleMask(1) << id;
+}
+
+constexpr MuscleMask ARM_MUSCLES = muscleBit(MUSCLE_BICEPS) | muscleBit(MUSCLE_TRICEPS);
+constexpr MuscleMask LEG_MUSCLES = muscleBit(MUSCLE_QUADS) | muscleBit(MUSCLE_HAMSTRINGS);
+constexpr MuscleMask UPPER_BODY = muscleBit(MUSCLE_CHEST) | muscleBit(MUSCLE_BACK) |
+                                  muscleBit(MUSCLE_SHOULDERS) | ARM_MUSCLES;
+constexpr MuscleMask LOWER_BODY = LEG_MUSCLES | muscleBit(MUSCLE_GLUTES) | muscleBit(MUSCLE_CALVES);
+
+//count per muscle id, used instead of maps keyed by muscle name
+using MuscleHistogram = array<int, MAX_MUSCLES>;
+
+//id of the name, -1 if no loaded catalog uses it. Never adds anything so it is safe for names
+//that come with a request.
+int muscleId(const string& name);
+//Finds or adds a name from a catalog. Only the loaders call it, the table is shared by the whole
+//process and has MAX_MUSCLES slots. Returns -1 with an error once it is full.
+int internMuscle(const string& name);
+const string& muscleName(int id);
+
+//mask of the muscles with the UI aliases expanded, names that aren't known add nothing
+MuscleMask muscleMaskOf(const string& name);
+MuscleMask muscleMaskOf(const vector<string>& names);
+MuscleMask muscleIdMask(int id);
+
+//muscle names in id order
+vector<string> muscleNames(MuscleMask mask);
+
+//The names of the muscles in a mask in id order, read from the muscle table one bit at a time
+//so nothing gets allocated.
+//    for (const string& name : MuscleNameView(mask))
+class MuscleNameView {
+private:
+    MuscleMask mask = 0;
+
+public:
+    class iterator {
+    private:
+        MuscleMask rest = 0;
+
+    public:
+        using value_type = string;
+        using difference_type = ptrdiff_t;
+
+        iterator() = default;
+        explicit iterator(MuscleMask muscles) : rest(muscles) {}
+
+        const string& operator*() const { return muscleName(countr_zero(rest)); }
+        iterator& operator++() {
+            rest &= rest - 1;
+            return *this;
+        }
+        iterator operator++(int) {
+            iterator before = *this;
+            ++*this;
+            return before;
+        }
+        bool operator==(default_sentinel_t) const { return rest == 0; }
+    };
+
+    MuscleNameView() = default;
+    explicit MuscleNameView(MuscleMask muscles) : mask(muscles) {}
+
+    iterator begin() const { return iterator(mask); }
+    default_sentinel_t end() const { return default_sentinel; }
+    size_t size() const { return popcount(mask); }
+    bool empty() const { return mask == 0; }
+};
+
+void addMuscles(MuscleHistogram& histogram, MuscleMask mask);
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef PLANCACHE_H
+#define PLANCACHE_H
+
+#include "WorkoutPlanner.h"
+#include "ExerciseCatalog.h"
+#include "User.h"
+#include <string>
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <mutex>
+#include <memory>
+#include <cstdint>
+
+using namespace std;
+
+//Optional LRU cache of finished plans. Users with the same days, equipment, priorities and goal
+//get the same plan for the same seed, so only the calories (which use the weight) are redone on a hit.
+//Safe to share between threads. Nothing in the planner uses it on its own, a server that plans for
+//many users puts it in front of WorkoutPlanner::makePlan and calls getPlan instead.
+class PlanCache {
+private:
+    struct Entry {
+        string key;
+        vector<WorkoutSession> plan;
+    };
+
+    size_t capacity;
+    mutex lock;
+    list<Entry> entries;    //most recently used first
+    unordered_map<string, list<Entry>::iterator> index;
+    shared_ptr<const ExerciseCatalog> catalog;    //catalog the cached plans were made from
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+
+    void clearLocked();
+
+public:
+    explicit PlanCache(size_t maxPlans = 1024);
+
+    //the planning inputs of a user written out in a fixed order, equipment sorted and every
+    //name length prefixed so different inputs never give the same key
+    static string makeKey(const User& user, uint64_t seed);
+
+    //cached plan when there is one, otherwise makes it with the planner and stores it.
+    //Everything cached is dropped when the planner has a different catalog than last time.
+    vector<WorkoutSession> getPlan(const WorkoutPlanner& planner, const User& user, uint64_t seed);
+
+    //drops every plan, call after reloading the catalog
+    void invalidate();
+
+    size_t size();
+    uint64_t getHits();
+    uint64_t getMisses();
+};
+
+#endif
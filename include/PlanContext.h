@@ -0,0 +1,52 @@
+#ifndef PLANCONTEXT_H
+#define PLANCONTEXT_H
+
+#include "User.h"
+#include "Muscle.h"
+#include "Fatigue.h"
+#include "ExerciseCatalog.h"
+#include "ScratchArena.h"
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <memory_resource>
+#include <memory>
+#include <random>
+#include <cstdint>
+
+using namespace std;
+
+//candidate list that only lives while a request runs, allocated from the request's scratch arena
+using ScratchList = pmr::vector<uint32_t>;
+
+//Everything that changes while one plan is being made. Each request gets its own context so
+//a shared catalog and planner can be used from many threads at once.
+class PlanContext {
+public:
+    User user;
+    mt19937 rng;
+    FatigueState fatigue;                            //muscles trained this week and the week before
+    unordered_map<uint32_t, int> exerciseCount;      //times each catalog index was picked this week
+
+    //Exercises the user has the equipment for, looked up once at the start of each plan from
+    //the pools the catalog shares between users. Only valid while that catalog is alive.
+    const EligiblePool* pool = nullptr;
+    shared_ptr<const EligiblePool> poolStorage;   //keeps the pool alive when the catalog couldn't cache it
+    vector<uint32_t> underRepeatLimit;   //pool minus the ones picked twice, made on first use and kept up to date
+    bool repeatPoolReady = false;
+    MuscleMask favored = 0;   //the user's high priority muscles, picked more often when filling a day
+    ScratchArena* arena = nullptr;   //where temporaries go, nullptr uses the calling thread's arena
+
+    PlanContext();
+    explicit PlanContext(const User& u);
+    //same user and seed always gives the same plan
+    PlanContext(const User& u, uint64_t seed);
+
+    //clears recovery and repeat tracking, keeps the user and rng
+    void reset();
+
+    ScratchArena& scratchArena() const;
+    pmr::memory_resource* scratch() const;
+};
+
+#endif
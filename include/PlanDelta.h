@@ -0,0 +1,38 @@
+#ifndef PLANDELTA_H
+#define PLANDELTA_H
+
+#include "User.h"
+#include <string>
+
+using namespace std;
+
+enum class DeltaKind {
+    ADD_DAY,
+    REMOVE_DAY,
+    MOVE_DAY,
+    SET_PRIORITY,
+    TOGGLE_EQUIPMENT
+};
+
+//One edit a user makes to their settings after getting a plan, so the planner can
+//update that plan instead of making a new one
+struct PlanDelta {
+    DeltaKind kind;
+    Weekday day = MONDAY;      //day added, removed or moved away from
+    Weekday toDay = MONDAY;    //where a moved day goes
+    string muscle = "";        //muscle whose priority is set
+    Priority priority = Priority::MEDIUM;
+    string equipment = "";     //item toggled
+
+    static PlanDelta addDay(Weekday day);
+    static PlanDelta removeDay(Weekday day);
+    static PlanDelta moveDay(Weekday from, Weekday to);
+    static PlanDelta setPriority(const string& muscle, Priority priority);
+    static PlanDelta toggleEquipment(const string& equipment);
+};
+
+//Changes the user the way the delta says. false if it doesn't fit the user,
+//like removing a day they don't train on
+bool applyDelta(User& user, const PlanDelta& delta);
+
+#endif
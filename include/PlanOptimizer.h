@@ -0,0 +1,48 @@
+#ifndef PLANOPTIMIZER_H
+#define PLANOPTIMIZER_H
+
+#include "ExerciseCatalog.h"
+#include "WorkoutSession.h"
+#include "User.h"
+#include "Muscle.h"
+#include "Fatigue.h"
+#include <vector>
+#include <array>
+#include <random>
+#include <chrono>
+#include <functional>
+
+using namespace std;
+
+//One day of the plan as the optimizer sees it
+struct PlanDay {
+    Weekday weekday;          //days close together need recovery
+    MuscleMask focus;         //what the session is named after, 0 if nothing
+    vector<PlannedExercise> exercises;
+};
+
+//Improves a finished weekly plan by local search. Random moves replace one exercise with another
+//from the pool or swap exercises between two days, and a move is kept when the score doesn't drop.
+//The score rewards priority muscle coverage and the day's focus, and costs repeats, muscles
+//trained again inside their recovery window (see FatigueState, the week wraps from Sunday to Monday)
+//and sessions outside the time window.
+class PlanOptimizer {
+private:
+    const ExerciseCatalog& catalog;
+    const EligiblePool& pool;
+    function<int(uint32_t)> timeOf;   //minutes for an exercise with the user's goal
+    array<int, MAX_MUSCLES> priorityWeight{};
+    int minTime;
+    int maxTime;
+
+public:
+    PlanOptimizer(const ExerciseCatalog& exerciseCatalog, const EligiblePool& eligible, const User& user,
+                  function<int(uint32_t)> exerciseTime, int minMinutes = 45, int maxMinutes = 90);
+
+    int score(const vector<PlanDay>& days) const;
+
+    //best plan found before the deadline, at least as good as the one passed in
+    vector<PlanDay> optimize(vector<PlanDay> days, mt19937& rng, chrono::steady_clock::time_point deadline) const;
+};
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef PLANSERIALIZER_H
+#define PLANSERIALIZER_H
+
+#include "WorkoutSession.h"
+#include "ExerciseCatalog.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <span>
+#include <memory>
+#include <cstdint>
+
+using namespace std;
+
+//Machine readable plan output. The writers append to a buffer the caller owns, so a server can clear
+//and reuse one buffer per request. Numbers go through to_chars and nothing builds a json object.
+enum class PlanFormat {
+    JSON,     //{"sessions":[...],"total_workouts":n,"total_calories":n}
+    NDJSON,   //one session object per line
+    CSV,      //one row per exercise with a header row
+    BINARY    //compact, see below
+};
+
+//Binary plan, little endian on every machine:
+//  magic | version u32 | catalog size u32 | session count u32
+//  per session: day u8 | type u8 | name length u16 | exercise count u16 | name | (index u32, minutes u16) per exercise
+//A plan with a count or number too big for its field isn't written, the writer fails instead.
+//Exercises are catalog indexes, so it can only be read back against the catalog it was made from.
+//Duration, calories and muscles aren't stored since the session works them out again.
+constexpr char PLAN_MAGIC[8] = {'S', 'W', 'P', 'P', 'L', 'A', 'N', '\0'};
+constexpr uint32_t PLAN_VERSION = 1;
+
+//"json", "ndjson", "csv" or "binary", false if it is none of them
+bool planFormatOf(const string& name, PlanFormat& format);
+
+//false with an error when the plan can't be written in that format, out is left as it was
+bool writePlan(span<const WorkoutSession> plan, PlanFormat format, string& out);
+void writePlanJson(span<const WorkoutSession> plan, string& out);
+void writePlanNdjson(span<const WorkoutSession> plan, string& out);
+void writePlanCsv(span<const WorkoutSession> plan, string& out);
+bool writePlanBinary(span<const WorkoutSession> plan, string& out);
+
+//a single session as the same object the JSON and NDJSON plans hold
+void writeSessionJson(const WorkoutSession& session, string& out);
+
+//rebuilds the sessions written by writePlanBinary, false if the data is invalid or from another catalog
+bool readPlanBinary(string_view data, shared_ptr<const ExerciseCatalog> catalog, double userWeight,
+                    vector<WorkoutSession>& plan);
+
+#endif
@@ -0,0 +1,70 @@
+#ifndef PLANWEEKS_H
+#define PLANWEEKS_H
+
+#include "WorkoutPlanner.h"
+#include "PlanContext.h"
+#include "WorkoutSession.h"
+#include "Calendar.h"
+#include <vector>
+#include <optional>
+#include <chrono>
+#include <iterator>
+#include <cstddef>
+
+using namespace std;
+
+//Consecutive weeks of plans for one user, each made when the range gets to it. Only the
+//week being looked at is kept, it is also all the next week needs: its picks count toward the
+//repeat limit of the next week (so the limit covers a rolling two weeks) and its fatigue
+//carries into the start of the next week.
+//    for (const vector<WorkoutSession>& week : PlanWeeks(planner, PlanContext(user, seed), 52))
+//With a TrainingSchedule the training days of each week come from the calendar instead of the
+//user's weekdays, so an every 3rd day schedule lands on different weekdays from week to week.
+//The planner has to outlive the range.
+class PlanWeeks {
+private:
+    const WorkoutPlanner& planner;
+    PlanContext ctx;
+    size_t weekCount;
+    size_t made = 0;
+    vector<WorkoutSession> current;
+    optional<TrainingSchedule> schedule;
+    chrono::sys_days firstMonday{};
+
+public:
+    class iterator {
+    private:
+        PlanWeeks* weeks = nullptr;
+
+    public:
+        using value_type = vector<WorkoutSession>;
+        using difference_type = ptrdiff_t;
+
+        iterator() = default;
+        explicit iterator(PlanWeeks* owner);
+
+        const vector<WorkoutSession>& operator*() const;
+        iterator& operator++();
+        void operator++(int);
+        bool operator==(default_sentinel_t) const;
+    };
+
+    PlanWeeks(const WorkoutPlanner& workoutPlanner, PlanContext context, size_t weeks);
+    //weeks from the one firstDay is in, training on the schedule's days
+    PlanWeeks(const WorkoutPlanner& workoutPlanner, PlanContext context, const TrainingSchedule& dates,
+              chrono::sys_days firstDay, size_t weeks);
+
+    //makes the first week if nothing was made yet
+    iterator begin();
+    default_sentinel_t end() const;
+
+    //makes the next week in place of the current one, false after the last week
+    bool next();
+    const vector<WorkoutSession>& week() const;
+    size_t weekNumber() const;   //1 for the first week, 0 before it
+    //Monday of the current week, only means something for a schedule
+    chrono::sys_days weekStart() const;
+    bool finished() const;
+};
+
+#endif
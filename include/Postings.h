@@ -0,0 +1,25 @@
+#ifndef POSTINGS_H
+#define POSTINGS_H
+
+#include <vector>
+#include <span>
+#include <memory_resource>
+#include <cstdint>
+
+using namespace std;
+
+//A posting list is a sorted list of catalog indices without duplicates, like all exercises for one
+//muscle. Queries are answered by combining them instead of scanning the catalog.
+using PostingList = vector<uint32_t>;
+
+//Indices in both lists. When one list is much shorter it gallops through the longer one,
+//so the cost follows the short list and not the catalog size.
+PostingList intersectPostings(const PostingList& a, const PostingList& b);
+
+//indices in any of the lists
+PostingList unionPostings(const PostingList& a, const PostingList& b);
+PostingList unionPostings(const vector<const PostingList*>& lists);
+//same, for a result that is only needed while a request runs. The result and the merge state come from scratch
+pmr::vector<uint32_t> unionPostings(span<const PostingList* const> lists, pmr::memory_resource* scratch);
+
+#endif
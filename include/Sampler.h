@@ -0,0 +1,53 @@
+#ifndef SAMPLER_H
+#define SAMPLER_H
+
+#include <vector>
+#include <span>
+#include <memory_resource>
+#include <random>
+#include <utility>
+#include <cstdint>
+
+using namespace std;
+
+//Draws items from a list in random order without copying or shuffling it. It is a partial
+//Fisher-Yates where only the swapped positions are remembered, so k draws cost O(k) however long
+//the list is. The list has to stay alive and unchanged while sampling.
+class Sampler {
+private:
+    span<const uint32_t> items;
+    size_t drawn = 0;
+    pmr::vector<pair<size_t, uint32_t>> moved;   //position -> item swapped there, only a few so a linear search
+
+    uint32_t at(size_t pos) const;
+    uint32_t take(size_t pos);
+    size_t randomPos(mt19937& rng) const;
+
+public:
+    explicit Sampler(span<const uint32_t> list, pmr::memory_resource* scratch = pmr::get_default_resource());
+
+    size_t remaining() const;
+
+    //next item, every remaining one equally likely. false once the list is used up
+    bool next(mt19937& rng, uint32_t& item);
+
+    //Next item with chance proportional to weight(item), for weights between 0 and maxWeight.
+    //Rejection sampling so no table is built over the list, after a while without a hit
+    //it settles for a uniform pick.
+    template <class Weight>
+    bool next(mt19937& rng, uint32_t& item, Weight weight, double maxWeight) {
+        if (remaining() == 0) return false;
+        uniform_real_distribution<double> accept(0.0, maxWeight);
+        for (int tries = 0; tries < 64; tries++) {
+            size_t pos = randomPos(rng);
+            //rejected items stay in place so they can still be drawn later
+            if (accept(rng) < weight(at(pos))) {
+                item = take(pos);
+                return true;
+            }
+        }
+        return next(rng, item);
+    }
+};
+
+#endif
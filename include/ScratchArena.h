@@ -0,0 +1,47 @@
+#ifndef SCRATCHARENA_H
+#define SCRATCHARENA_H
+
+#include <memory_resource>
+#include <vector>
+#include <cstddef>
+
+using namespace std;
+
+//Memory for the temporaries of one request, candidate lists, packer items and so on. Allocating is
+//a pointer bump and nothing is freed one by one, everything goes at once when the request is done.
+//The first block is kept between requests so a warmed up thread doesn't call malloc for scratch data.
+//Not thread safe, each thread uses its own through forThread().
+class ScratchArena {
+private:
+    vector<byte> initial;
+    pmr::monotonic_buffer_resource arena;
+    int depth = 0;
+
+    friend class ScratchScope;
+
+public:
+    explicit ScratchArena(size_t initialBytes = 64 * 1024);
+    ScratchArena(const ScratchArena&) = delete;
+    ScratchArena& operator=(const ScratchArena&) = delete;
+
+    pmr::memory_resource* resource();
+    //drops everything allocated so far, the next allocation starts at the first block again
+    void reset();
+
+    static ScratchArena& forThread();
+};
+
+//Marks one request on an arena. The arena is reset when the outermost scope ends, so a request
+//calling another one (makePlan inside updatePlan) doesn't free the data of the caller.
+class ScratchScope {
+private:
+    ScratchArena& arena;
+
+public:
+    explicit ScratchScope(ScratchArena& scratchArena);
+    ~ScratchScope();
+    ScratchScope(const ScratchScope&) = delete;
+    ScratchScope& operator=(const ScratchScope&) = delete;
+};
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef SESSIONPACKER_H
+#define SESSIONPACKER_H
+
+#include <vector>
+#include <span>
+#include <memory_resource>
+#include <cstdint>
+#include <cstddef>
+
+using namespace std;
+
+//longest session the packer can plan, rest time included
+constexpr int MAX_SESSION_MINUTES = 240;
+//candidates looked at per session, keeps the cost per session fixed
+constexpr size_t MAX_PACK_ITEMS = 32;
+
+//One exercise that could go in the session. Minutes include the rest after it, value is how much
+//the session wants it and can be negative for exercises only worth adding to reach the window.
+struct PackItem {
+    uint32_t index;
+    int minutes;
+    int value;
+};
+
+//Picks the items with the highest total value whose minutes add up to something in [minTime, maxTime].
+//A subset sum over a bitset checks first if the window can be hit at all, then a knapsack over the
+//minutes finds the best set. If nothing lands in the window the longest set under maxTime is used.
+//Returns positions into items in their original order, only the first MAX_PACK_ITEMS are looked at.
+pmr::vector<size_t> packSession(span<const PackItem> items, int minTime, int maxTime,
+                                pmr::memory_resource* scratch = pmr::get_default_resource());
+
+#endif
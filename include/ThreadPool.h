@@ -0,0 +1,50 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <memory>
+
+using namespace std;
+
+//Work stealing thread pool. Every worker has its own queue and takes from the back of it,
+//when it runs out it steals from the front of the other queues so a few slow plans don't
+//leave the rest of the cores idle.
+class ThreadPool {
+private:
+    struct Queue {
+        deque<function<void()>> tasks;
+        mutex lock;
+    };
+
+    vector<unique_ptr<Queue>> queues;
+    vector<thread> workers;
+    mutex sleepLock;
+    condition_variable wake;
+    atomic<size_t> queued{0};
+    atomic<size_t> nextQueue{0};
+    bool stopping = false;
+
+    bool popTask(size_t self, function<void()>& task);
+    void run(size_t self);
+
+public:
+    //0 uses one thread per core
+    explicit ThreadPool(size_t threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void submit(function<void()> task);
+    size_t size() const;
+    //true when called from a task running on this pool, waiting on other tasks there can deadlock
+    bool onWorker() const;
+};
+
+#endif
@@ -7,6 +7,7 @@
 #include <map>
 #include <iostream>
 #include <iomanip>
+#include "Calendar.h"
 
 using namespace std;
 
@@ -32,14 +33,14 @@ public:
     int weight; // in kg
     int age;
     string gender;
-    vector<string> workoutDays;
+    DayMask workoutDays;   //one bit per training day, see Calendar.h
     unordered_set<string> equipment;
     map<string, Priority> priorities;
     Goal goal;
 
     User();     //Constructors
 
-    User(string n,int h, int w,int a,string g,vector<string> days,
+    User(string n,int h, int w,int a,string g,DayMask days,
          unordered_set<string> equip, map<string,Priority> priority,Goal userGoal);
 
     //Health stats
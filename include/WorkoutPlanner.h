@@ -2,56 +2,111 @@
 #define WORKOUTPLANNER_H
 
 #include "Exercise.h"
+#include "Equipment.h"
+#include "Muscle.h"
+#include "ExerciseCatalog.h"
+#include "PlanContext.h"
 #include "User.h"
 #include "WorkoutSession.h"
+#include "ThreadPool.h"
+#include "PlanDelta.h"
 #include <vector>
 #include <string>
+#include <memory>
+#include <span>
+#include <chrono>
 #include <unordered_map>
 #include <unordered_set>
-#include <random>
 
 using namespace std;
 
+//Plan for one user of a batch, error is set instead if making that users plan failed
+struct PlanResult {
+    vector<WorkoutSession> plan;
+    string error;
+
+    bool ok() const { return error.empty(); }
+};
+
+//Builds plans from a shared catalog. The functions taking a PlanContext are const and only change
+//the context, so one planner can serve many requests on different threads.
+//The functions without a context use the planner's own context for the single user case.
 class WorkoutPlanner {
 private:
-    vector<Exercise> exercises;
-    User user;
-    unordered_map<string, vector<string>> lastTrained;
-    mutable unordered_map<string, int> exerciseCount;
-    mutable mt19937 rng;
-
-    // Filtering
-    vector<Exercise> filterEquipment(const vector<Exercise>& list) const;
-    vector<Exercise> filterMuscles(const vector<Exercise>& list, const vector<string>& targets) const;
-    vector<Exercise> getCompounds() const;
-
-    vector<Exercise> avoidRecent(const vector<Exercise>& list, const string& day) const;
-    vector<Exercise> limitRepeats(const vector<Exercise>& list) const;
-
-    vector<Exercise> ensureMin(vector<Exercise> list, int min) const;
-    vector<Exercise> limitTime(const vector<Exercise>& list, int minTime, int maxTime) const;
+    shared_ptr<const ExerciseCatalog> catalog;
+    PlanContext context;
+
+    void preparePool(PlanContext& ctx) const;
+    void countPick(uint32_t index, PlanContext& ctx) const;
+    const vector<uint32_t>& repeatPool(PlanContext& ctx) const;
+    ScratchList musclePool(const EligiblePool& pool, MuscleMask targets, const PlanContext& ctx) const;
+    double pickWeight(uint32_t index, const PlanContext& ctx) const;
+    vector<PlannedExercise> buildDay(PlanContext& ctx) const;
+    vector<string> priorityMuscles(const User& user) const;
+    string dayFocus(int dayIdx, const vector<string>& allMuscles, const User& user) const;
+    vector<PlannedExercise> buildSession(Weekday day, const string& primaryMuscle,
+                                         const vector<string>& allMuscles, PlanContext& ctx) const;
+    WorkoutSession finishSession(Weekday day, const string& primaryMuscle,
+                                 vector<PlannedExercise> planned, PlanContext& ctx) const;
+    string sessionFocus(const WorkoutSession& session) const;
+
+    //Candidate lists inside a request come from ctx.scratch(), the public functions open a ScratchScope
+    //so all of it is dropped at once when they return
+    ScratchList avoidRecent(span<const uint32_t> list, Weekday day, const PlanContext& ctx) const;
+    ScratchList limitRepeats(span<const uint32_t> list, const PlanContext& ctx) const;
+
+    ScratchList ensureMin(ScratchList list, size_t min, PlanContext& ctx) const;
+    vector<PlannedExercise> limitTime(vector<PlannedExercise> list, int minTime, int maxTime, PlanContext& ctx) const;
     //Session logic
-    SessionType getType(const vector<Exercise>& list) const;
-    string getName(const vector<Exercise>& list) const;
-    vector<string> expandMuscles(const vector<string>& muscles) const;  // ADD THIS LINE
-    bool hasCardioBack(const vector<WorkoutSession>& plan, const string& day) const;
-    bool hasLowerBack(const vector<WorkoutSession>& plan, const string& day) const;
-    vector<string> getPrevDay(const string& day) const;
-    int getDayNum(const string& day) const;
+    SessionType getType(const vector<PlannedExercise>& list) const;
+    string getName(const vector<PlannedExercise>& list) const;
+    bool hasCardioBack(const PlanContext& ctx, Weekday day) const;
+    bool hasLowerBack(const PlanContext& ctx, Weekday day) const;
     int getTime(const Exercise& ex, Goal goal) const;
 
-    //Equipment expansion toggle option
-    unordered_set<string> expandEquipment(const unordered_set<string>& equipment) const;
+    //Equipment with the categories expanded
+    EquipmentMask ownedEquipment(const User& user) const;
 
 public:
     WorkoutPlanner();
+    explicit WorkoutPlanner(shared_ptr<const ExerciseCatalog> exerciseCatalog);
 
     bool loadData(const string& filename);
+    void setCatalog(shared_ptr<const ExerciseCatalog> exerciseCatalog);
+    shared_ptr<const ExerciseCatalog> getCatalog() const;
+
+    // Filtering, works on indices into the catalog so nothing gets copied between steps
+    vector<uint32_t> filterEquipment(const PlanContext& ctx) const;
+    vector<uint32_t> filterEquipment(const vector<uint32_t>& list, const PlanContext& ctx) const;
+    vector<uint32_t> filterMuscles(const vector<uint32_t>& list, const vector<string>& targets) const;
+    vector<uint32_t> getCompounds() const;
+    //Equipment, muscle and repeat limit in one scan over the whole catalog table, for bulk jobs
+    //that regenerate plans against everything. targets 0 keeps every muscle.
+    vector<uint32_t> filterExercises(const PlanContext& ctx, MuscleMask targets, bool compoundOnly = false) const;
+
     void setUser(const User& u);
+    void setSeed(uint64_t seed);
     vector<WorkoutSession> makePlan();
-    vector<Exercise> makeDay();
+    vector<WorkoutSession> makePlan(PlanContext& ctx) const;
+    //makePlan without starting over, the repeat counts and fatigue already in ctx count for this week
+    vector<WorkoutSession> makeNextWeek(PlanContext& ctx) const;
+    //Optimizer mode, the greedy plan improved by local search for as long as the budget allows.
+    //Returns within the budget unless the greedy plan alone takes longer.
+    vector<WorkoutSession> makePlan(PlanContext& ctx, chrono::microseconds budget) const;
+    //Applies one edit to a plan made before for ctx.user and updates ctx.user to match. Sessions whose
+    //inputs didn't change are kept as they are, only new or changed days and the days after them that
+    //would now train the same muscles back to back are picked again.
+    vector<WorkoutSession> updatePlan(const vector<WorkoutSession>& previous, const PlanDelta& delta, PlanContext& ctx) const;
+    //Makes plans for many users at once on a thread pool, results are in the same order as users.
+    //An error for one user doesn't stop the others. Called from a task running on the same pool
+    //(including the shared one) the batch is planned on the calling thread instead of waiting on the pool.
+    vector<PlanResult> makePlans(span<const User> users) const;
+    vector<PlanResult> makePlans(span<const User> users, ThreadPool& pool) const;
+    vector<PlannedExercise> makeDay();
+    vector<PlannedExercise> makeDay(PlanContext& ctx) const;
     void showPlan(const vector<WorkoutSession>& plan) const;
     void showAnalysis() const;
+    void showAnalysis(const User& user) const;
     int getCalories(const vector<WorkoutSession>& plan) const;
 };
 
@@ -2,8 +2,14 @@
 #define WORKOUTSESSION_H
 
 #include "Exercise.h"
+#include "ExerciseCatalog.h"
+#include "Calendar.h"
 #include <vector>
 #include <string>
+#include <memory>
+#include <cstdint>
+#include <span>
+#include <string_view>
 
 using namespace std;
 
@@ -14,34 +20,53 @@ enum class SessionType {
     FULL_BODY
 };
 
+//An exercise picked for a session. Points into the catalog and keeps the time it takes in this
+//session, since that depends on the users goal instead of the catalog.
+struct PlannedExercise {
+    uint32_t index;
+    int duration;
+};
+
 class WorkoutSession {
 private:
-    string day;
+    Weekday day;
     string name;
-    vector<Exercise> exercises;
+    shared_ptr<const ExerciseCatalog> catalog;
+    vector<PlannedExercise> exercises;
     SessionType type;
     int duration;
     int calories;
     double weight;
+    MuscleMask muscles;   //worked out once when the session is built
 
     void calcStats();
 
 public:
-    WorkoutSession(const string& workoutDay,
-                const vector<Exercise>& exs,
+    WorkoutSession(Weekday workoutDay,
+                   shared_ptr<const ExerciseCatalog> exerciseCatalog,
+                   vector<PlannedExercise> exs,
                    SessionType sessionType,
-                   double userWeight=70.0);
+                   double userWeight=70.0,
+                   string sessionName="");
 
-    //Get info OF SESSION
-    string getDay() const;
-    string getSessionName() const;
-    vector<Exercise> getExercises() const;
+    //Get info OF SESSION, nothing here copies the exercises
+    Weekday getDay() const;
+    const string& getSessionName() const;
+    span<const PlannedExercise> getExercises() const;
+    size_t exerciseCount() const;
+    //the catalog entry of the i'th exercise, its time in this session is in getExercises()[i]
+    ExerciseView exercise(size_t i) const;
+    const ExerciseCatalog& getCatalog() const;
     SessionType getSessionType() const;
     int getDuration() const;
     int getCaloriesBurned() const;
-    string getTypeString() const;
-    vector<string> getMuscles() const;
+    string_view getTypeString() const;
+    //names of the muscles the session works, read from the mask made when it was built
+    MuscleNameView getMuscles() const;
+    MuscleMask getMuscleMask() const;
     void setSessionName(const string& sessionName);
+    //recalculates calories for another body weight, the exercises don't change
+    void setUserWeight(double userWeight);
 
     // Checks workout
     bool tooLong(int maxTime) const;
@@ -2,6 +2,8 @@
 #define HELPERS_H
 
 #include "Exercise.h"
+#include "Equipment.h"
+#include "WorkoutSession.h"
 #include "json.hpp"
 #include <vector>
 #include <string>
@@ -11,7 +13,8 @@
 using namespace std;
 using json = nlohmann::json;
 
-vector<Exercise> loadDatabase(const string& filename);
+//the exercises' text goes into store, which has to outlive them
+vector<Exercise> loadDatabase(const string& filename, EquipmentVocab& vocab, ExerciseStore& store);
 
 string toLowerCase(const string& text);
 string formatText(const unordered_map<string, string>& data);
@@ -24,6 +27,7 @@ bool isCategory(const string& name);
 vector<string> expandCategory(const string& category);
 
 bool checkDuration(const vector<Exercise>& exercises, int minTime = 45, int maxTime = 90);
-unordered_map<string, int> countMuscles(const vector<Exercise>& exercises);
+bool checkDuration(const vector<PlannedExercise>& exercises, int minTime = 45, int maxTime = 90);
+MuscleHistogram countMuscles(const vector<Exercise>& exercises);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,132 @@
+//Weekdays and training schedules without comparing day names in the planner
+#include "Calendar.h"
+#include <algorithm>
+#include <bit>
+
+static const array<string, DAYS_IN_WEEK> names = {
+    "Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday", "Sunday"
+};
+
+int weekdayId(const string& name) {
+    auto it = find(names.begin(), names.end(), name);
+    return it != names.end() ? (int)distance(names.begin(), it) : -1;
+}
+
+const string& weekdayName(int day) {
+    return names.at(day);
+}
+
+DayMask dayMaskOf(const vector<string>& dayNames) {
+    DayMask days = 0;
+    for (const string& name : dayNames) {
+        int id = weekdayId(name);
+        if (id >= 0) days |= dayBit(id);
+    }
+    return days;
+}
+
+vector<Weekday> daysOf(DayMask days) {
+    vector<Weekday> result;
+    for (DayMask m = days & ALL_DAYS; m; m &= m - 1) {
+        result.push_back((Weekday)countr_zero((unsigned)m));
+    }
+    return result;
+}
+
+static WeekTables buildTables() {
+    WeekTables tables;
+    for (int days = 0; days < 128; days++) {
+        for (int day = 0; day < DAYS_IN_WEEK; day++) {
+            tables.previous[days][day] = DAYS_IN_WEEK;
+            tables.restGap[days][day] = 0;
+            tables.nextGap[days][day] = 0;
+            for (int gap = 1; gap <= DAYS_IN_WEEK; gap++) {
+                int before = (day - gap + DAYS_IN_WEEK) % DAYS_IN_WEEK;
+                if (days & dayBit(before)) {
+                    tables.previous[days][day] = before;
+                    tables.restGap[days][day] = gap;
+                    break;
+                }
+            }
+            for (int gap = 0; gap < DAYS_IN_WEEK; gap++) {
+                if (days & dayBit((day + gap) % DAYS_IN_WEEK)) {
+                    tables.nextGap[days][day] = gap;
+                    break;
+                }
+            }
+        }
+    }
+    return tables;
+}
+
+const WeekTables& weekTables() {
+    static const WeekTables tables = buildTables();
+    return tables;
+}
+
+Weekday weekdayOf(chrono::sys_days date) {
+    //iso_encoding is 1 for Monday to 7 for Sunday
+    return (Weekday)(chrono::weekday(date).iso_encoding() - 1);
+}
+
+TrainingSchedule TrainingSchedule::weekly(DayMask days) {
+    TrainingSchedule schedule;
+    schedule.weekdays = days & ALL_DAYS;
+    return schedule;
+}
+
+TrainingSchedule TrainingSchedule::everyNDays(int days, chrono::sys_days firstDay) {
+    TrainingSchedule schedule;
+    schedule.interval = max(1, days);
+    schedule.start = firstDay;
+    return schedule;
+}
+
+bool TrainingSchedule::trainsOn(chrono::sys_days date) const {
+    if (interval) {
+        int since = (date - start).count();
+        return since >= 0 && since % interval == 0;
+    }
+    return weekdays & dayBit(weekdayOf(date));
+}
+
+chrono::sys_days TrainingSchedule::previous(chrono::sys_days date) const {
+    if (interval) {
+        int since = (date - start).count();
+        if (since <= 0) return date;
+        int back = since % interval ? since % interval : interval;
+        return date - chrono::days(back);
+    }
+    int gap = restGap(weekdays, weekdayOf(date));
+    return gap ? date - chrono::days(gap) : date;
+}
+
+chrono::sys_days TrainingSchedule::next(chrono::sys_days date) const {
+    if (interval) {
+        int since = (date - start).count();
+        if (since <= 0) return start;
+        int ahead = since % interval ? interval - since % interval : 0;
+        return date + chrono::days(ahead);
+    }
+    return date + chrono::days(nextGap(weekdays, weekdayOf(date)));
+}
+
+vector<chrono::sys_days> TrainingSchedule::between(chrono::sys_days from, chrono::sys_days to) const {
+    vector<chrono::sys_days> dates;
+    if (!interval && !weekdays) return dates;
+    for (chrono::sys_days date = next(from); date < to; date = next(date + chrono::days(1))) {
+        dates.push_back(date);
+    }
+    return dates;
+}
+
+DayMask TrainingSchedule::weekOf(chrono::sys_days date) const {
+    if (!interval) return weekdays;
+    chrono::sys_days monday = date - chrono::days(weekdayOf(date));
+    chrono::sys_days sunday = monday + chrono::days(DAYS_IN_WEEK - 1);
+    DayMask days = 0;
+    for (chrono::sys_days day = next(monday); day <= sunday; day += chrono::days(interval)) {
+        days |= dayBit(weekdayOf(day));
+    }
+    return days;
+}
@@ -0,0 +1,283 @@
+//Streaming and parallel loaders for large JSON catalogs
+#include "CatalogLoader.h"
+#include "MappedFile.h"
+#include "json.hpp"
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <cctype>
+#include <bit>
+
+using json = nlohmann::json;
+
+//SAX handler that only builds one array element at a time. elementLevel is how many containers are
+//open around an element: 1 when reading the whole array, 0 when it is handed one element at a time.
+class ExerciseSax : public nlohmann::json_sax<json> {
+private:
+    EquipmentVocab& vocab;
+    ExerciseStore& store;
+    const function<void(Exercise&&)>& emit;
+    size_t elementLevel;
+    size_t depth = 0;
+    json element;
+    vector<json*> stack;    //containers of the element that are still open
+    json::string_t lastKey;
+
+    //checks the finished element the same way loadDatabase does and hands it on
+    void finish() {
+        bool valid = element.is_object() && element.contains("exercise") &&
+                     element.contains("muscle_groups") && element.contains("equipment");
+        if (valid) {
+            try {
+                emit(Exercise::from_json(element, vocab, store));
+            } catch (const json::exception&) {
+                valid = false;
+            }
+        }
+        if (!valid) {
+            cerr << "Warning: Skipping invalid exercise." << endl;
+            skipped++;
+        }
+        element = json();
+    }
+
+    bool addValue(json value) {
+        if (depth < elementLevel) {
+            notArray = true;
+            return false;
+        }
+        if (stack.empty()) {
+            element = move(value);
+            finish();
+            return true;
+        }
+        json* parent = stack.back();
+        if (parent->is_object()) {
+            (*parent)[lastKey] = move(value);
+        } else {
+            parent->push_back(move(value));
+        }
+        return true;
+    }
+
+    bool startContainer(json container) {
+        if (depth < elementLevel) {
+            if (!container.is_array()) {
+                notArray = true;
+                return false;
+            }
+            depth++;
+            return true;
+        }
+
+        json* slot;
+        if (stack.empty()) {
+            element = move(container);
+            slot = &element;
+        } else if (stack.back()->is_object()) {
+            slot = &((*stack.back())[lastKey] = move(container));
+        } else {
+            stack.back()->push_back(move(container));
+            slot = &stack.back()->back();
+        }
+        stack.push_back(slot);
+        depth++;
+        return true;
+    }
+
+    bool endContainer() {
+        depth--;
+        if (stack.empty()) return true;  //end of the top level array
+        stack.pop_back();
+        if (stack.empty()) finish();
+        return true;
+    }
+
+public:
+    size_t skipped = 0;
+    bool notArray = false;
+    std::string error;
+
+    ExerciseSax(EquipmentVocab& equipmentVocab, ExerciseStore& exerciseStore,
+                const function<void(Exercise&&)>& onExercise, size_t level)
+        : vocab(equipmentVocab), store(exerciseStore), emit(onExercise), elementLevel(level) {}
+
+    bool null() override { return addValue(nullptr); }
+    bool boolean(bool val) override { return addValue(val); }
+    bool number_integer(number_integer_t val) override { return addValue(val); }
+    bool number_unsigned(number_unsigned_t val) override { return addValue(val); }
+    bool number_float(number_float_t val, const string_t&) override { return addValue(val); }
+    bool string(string_t& val) override { return addValue(move(val)); }
+    bool binary(binary_t& val) override { return addValue(json::binary(move(val))); }
+    bool start_object(std::size_t) override { return startContainer(json::object()); }
+    bool key(string_t& val) override {
+        lastKey = move(val);
+        return true;
+    }
+    bool end_object() override { return endContainer(); }
+    bool start_array(std::size_t) override { return startContainer(json::array()); }
+    bool end_array() override { return endContainer(); }
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& ex) override {
+        error = ex.what();
+        return false;
+    }
+};
+
+static void reportEquipmentOverflow() {
+    cerr << "Error: The catalog uses more than " << EquipmentVocab::MAX_BITS
+         << " different equipment items." << endl;
+}
+
+bool streamExercises(istream& input, EquipmentVocab& vocab, ExerciseStore& store,
+                     const function<void(Exercise&&)>& onExercise) {
+    ExerciseSax handler(vocab, store, onExercise, 1);
+    bool ok = json::sax_parse(input, &handler);
+    if (handler.notArray) {
+        cerr << "Error: Invalid JSON format." << endl;
+    } else if (!ok) {
+        cerr << "Error parsing file: " << handler.error << endl;
+    } else if (vocab.overflowed()) {
+        reportEquipmentOverflow();
+        return false;
+    }
+    return ok;
+}
+
+//Finds where every element of the top level array starts and ends without parsing them.
+//Only has to track strings and nesting, the elements themselves are checked when they are parsed.
+static bool splitElements(const char* data, size_t size, vector<pair<size_t, size_t>>& elements) {
+    size_t pos = 0;
+    while (pos < size && isspace((unsigned char)data[pos])) pos++;
+    if (pos == size || data[pos] != '[') return false;
+    pos++;
+
+    int depth = 0;
+    bool inString = false;
+    size_t start = pos;
+    for (; pos < size; pos++) {
+        char c = data[pos];
+        if (inString) {
+            if (c == '\\') pos++;
+            else if (c == '"') inString = false;
+            continue;
+        }
+        if (c == '"') {
+            inString = true;
+        } else if (c == '{' || c == '[') {
+            depth++;
+        } else if (c == '}' || c == ']') {
+            if (depth == 0) {
+                if (c != ']') return false;
+                break;
+            }
+            depth--;
+        } else if (c == ',' && depth == 0) {
+            elements.push_back({start, pos});
+            start = pos + 1;
+        }
+    }
+    if (pos == size) return false;
+
+    //the last element, or nothing for an empty array
+    size_t end = pos;
+    bool empty = true;
+    for (size_t i = start; i < end; i++) {
+        if (!isspace((unsigned char)data[i])) empty = false;
+    }
+    if (!empty) elements.push_back({start, end});
+    else if (!elements.empty()) return false;  //trailing comma
+
+    for (pos++; pos < size; pos++) {
+        if (!isspace((unsigned char)data[pos])) return false;
+    }
+    return true;
+}
+
+//what one thread parsed, ids in the vocab are local to the chunk until they are merged
+struct ParsedChunk {
+    vector<Exercise> exercises;
+    EquipmentVocab vocab;
+    ExerciseStore store;
+    std::string error;
+};
+
+shared_ptr<const ExerciseCatalog> loadCatalogParallel(const string& filename, size_t threads) {
+    MappedFile file(filename);
+    if (!file.data()) {
+        cerr << "File failed to open " << filename << endl;
+        return nullptr;
+    }
+
+    vector<pair<size_t, size_t>> elements;
+    if (!splitElements(file.data(), file.size(), elements)) {
+        cerr << "Error: Invalid JSON format." << endl;
+        return nullptr;
+    }
+
+    if (threads == 0) threads = max(1u, thread::hardware_concurrency());
+    threads = max<size_t>(1, min(threads, elements.size()));
+    vector<ParsedChunk> chunks(threads);
+    vector<thread> workers;
+
+    for (size_t t = 0; t < threads; t++) {
+        workers.emplace_back([&, t] {
+            ParsedChunk& chunk = chunks[t];
+            function<void(Exercise&&)> keep = [&chunk](Exercise&& ex) { chunk.exercises.push_back(move(ex)); };
+            ExerciseSax handler(chunk.vocab, chunk.store, keep, 0);
+
+            size_t first = elements.size() * t / threads;
+            size_t last = elements.size() * (t + 1) / threads;
+            for (size_t i = first; i < last; i++) {
+                const char* begin = file.data() + elements[i].first;
+                const char* end = file.data() + elements[i].second;
+                if (!json::sax_parse(begin, end, &handler)) {
+                    chunk.error = handler.error;
+                    return;
+                }
+            }
+        });
+    }
+    for (thread& worker : workers) {
+        worker.join();
+    }
+
+    //merges the chunks in file order, moving each chunks equipment ids over to the shared vocab
+    //and its text over to the shared store
+    vector<Exercise> exercises;
+    EquipmentVocab vocab;
+    ExerciseStore store;
+    for (ParsedChunk& chunk : chunks) {
+        if (!chunk.error.empty()) {
+            cerr << "Error parsing file: " << chunk.error << endl;
+            return nullptr;
+        }
+
+        if (chunk.vocab.overflowed()) {
+            reportEquipmentOverflow();
+            return nullptr;
+        }
+        vector<int> toShared(chunk.vocab.size());
+        for (size_t id = 0; id < chunk.vocab.size(); id++) {
+            toShared[id] = vocab.intern(chunk.vocab.name(id));
+            if (toShared[id] < 0) {
+                reportEquipmentOverflow();
+                return nullptr;
+            }
+        }
+        //every set bit is a chunk id, each one moves to its shared id
+        for (Exercise& ex : chunk.exercises) {
+            for (EquipmentMask& option : chunk.store.options(ex.firstOption, ex.optionCount)) {
+                EquipmentMask remapped = 0;
+                for (EquipmentMask bits = option; bits; bits &= bits - 1) {
+                    remapped |= EquipmentVocab::bit(toShared[countr_zero(bits)]);
+                }
+                option = remapped;
+            }
+            exercises.push_back(store.import(ex, chunk.store));
+        }
+        chunk.store = ExerciseStore();
+    }
+
+    cout << "Loaded " << exercises.size() << " exercises from file.\n";
+    return make_shared<const ExerciseCatalog>(move(exercises), move(vocab), move(store));
+}
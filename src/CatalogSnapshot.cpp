@@ -0,0 +1,257 @@
+//Writes and reads the binary catalog snapshot
+#include "CatalogSnapshot.h"
+#include "Muscle.h"
+#include "MappedFile.h"
+#include <fstream>
+#include <iostream>
+#include <cstring>
+#include <cstddef>
+#include <bit>
+#include <unordered_map>
+#include <vector>
+
+//the muscle and equipment names, the exercises' own text is written as the store has it
+class SnapshotWriter {
+public:
+    vector<SnapshotString> muscles;
+    vector<SnapshotString> equipment;
+    string pool;
+
+    SnapshotString add(string_view text) {
+        SnapshotString ref{(uint32_t)pool.size(), (uint32_t)text.size()};
+        pool += text;
+        return ref;
+    }
+};
+
+static_assert(is_trivially_copyable_v<Exercise> && is_standard_layout_v<Exercise>,
+              "snapshot records are Exercise objects read straight from the file");
+
+static uint64_t alignUp(uint64_t offset) {
+    return (offset + 7) & ~uint64_t(7);
+}
+
+bool isSnapshot(const string& filename) {
+    ifstream file(filename, ios::binary);
+    char magic[8] = {};
+    file.read(magic, sizeof(magic));
+    return file.gcount() == sizeof(magic) && memcmp(magic, SNAPSHOT_MAGIC, sizeof(magic)) == 0;
+}
+
+bool saveSnapshot(const ExerciseCatalog& catalog, const string& filename) {
+    SnapshotWriter writer;
+    span<const Exercise> records = catalog.getExercises();
+    const ExerciseStore& store = catalog.getStore();
+    string_view text = store.textData();
+    span<const EquipmentMask> options = store.allOptions();
+
+    //muscle ids are stored as the ids of this process, the names let a reader map them back
+    int maxMuscle = KNOWN_MUSCLES - 1;
+    for (const Exercise& ex : records) {
+        if (ex.muscleMask) maxMuscle = max(maxMuscle, (int)bit_width(ex.muscleMask) - 1);
+    }
+    for (int id = 0; id <= maxMuscle; id++) {
+        writer.muscles.push_back(writer.add(muscleName(id)));
+    }
+
+    const EquipmentVocab& vocab = catalog.getEquipmentVocab();
+    for (size_t id = 0; id < vocab.size(); id++) {
+        writer.equipment.push_back(writer.add(vocab.name(id)));
+    }
+
+    SnapshotHeader header{};
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.byteOrder = SNAPSHOT_BYTE_ORDER;
+    header.recordSize = sizeof(Exercise);
+    header.exerciseCount = records.size();
+    header.muscleCount = writer.muscles.size();
+    header.equipmentCount = writer.equipment.size();
+    header.optionCount = options.size();
+    header.namePoolSize = writer.pool.size();
+    header.textSize = text.size();
+
+    header.muscleOffset = alignUp(sizeof(SnapshotHeader));
+    header.equipmentOffset = alignUp(header.muscleOffset + writer.muscles.size() * sizeof(SnapshotString));
+    header.namePoolOffset = alignUp(header.equipmentOffset + writer.equipment.size() * sizeof(SnapshotString));
+    header.recordOffset = alignUp(header.namePoolOffset + writer.pool.size());
+    header.optionOffset = alignUp(header.recordOffset + records.size() * sizeof(Exercise));
+    header.textOffset = alignUp(header.optionOffset + options.size() * sizeof(EquipmentMask));
+
+    ofstream file(filename, ios::binary | ios::trunc);
+    if (!file.is_open()) {
+        cerr << "Error: Could not write snapshot: " << filename << endl;
+        return false;
+    }
+
+    auto writeAt = [&file](uint64_t offset, const void* data, size_t size) {
+        uint64_t position = file.tellp();
+        static const char zeros[8] = {};
+        file.write(zeros, offset - position);
+        file.write((const char*)data, size);
+    };
+    file.write((const char*)&header, sizeof(header));
+    writeAt(header.muscleOffset, writer.muscles.data(), writer.muscles.size() * sizeof(SnapshotString));
+    writeAt(header.equipmentOffset, writer.equipment.data(), writer.equipment.size() * sizeof(SnapshotString));
+    writeAt(header.namePoolOffset, writer.pool.data(), writer.pool.size());
+    writeAt(header.recordOffset, records.data(), records.size() * sizeof(Exercise));
+    writeAt(header.optionOffset, options.data(), options.size() * sizeof(EquipmentMask));
+    writeAt(header.textOffset, text.data(), text.size());
+
+    if (!file) {
+        cerr << "Error: Could not write snapshot: " << filename << endl;
+        return false;
+    }
+    return true;
+}
+
+//true if count items of itemSize starting at offset are inside the file
+static bool inFile(uint64_t offset, uint64_t count, uint64_t itemSize, size_t fileSize) {
+    if (offset > fileSize) return false;
+    return count <= (fileSize - offset) / itemSize;
+}
+
+//true if the record only references what the snapshot has, checked before the catalog uses it
+static bool validRecord(const char* raw, const SnapshotHeader& header, const ExerciseStore& store) {
+    Exercise ex;
+    memcpy(&ex, raw, sizeof(Exercise));
+    if (!store.validText(ex.nameRef) || !store.validText(ex.equipmentRef) || !store.validText(ex.categoryRef)) {
+        return false;
+    }
+    if ((uint64_t)ex.firstOption + ex.optionCount > header.optionCount) return false;
+    if (ex.muscleCount > Exercise::MAX_LISTED_MUSCLES) return false;
+    for (uint8_t id : ex.listedMuscles()) {
+        if (id >= header.muscleCount) return false;
+    }
+    if (header.muscleCount < MAX_MUSCLES && (ex.muscleMask >> header.muscleCount) != 0) return false;
+
+    //a bool that isn't 0 or 1 is undefined behaviour once the catalog reads it
+    uint8_t compound;
+    memcpy(&compound, raw + offsetof(Exercise, isCompound), 1);
+    return compound <= 1;
+}
+
+//same exercise with the snapshot's muscle ids replaced by the ones of this process
+static Exercise remapMuscles(const Exercise& record, const vector<int>& toLocal) {
+    Exercise ex = record;
+    ex.muscleMask = 0;
+    for (MuscleMask mask = record.muscleMask; mask; mask &= mask - 1) {
+        ex.muscleMask |= muscleIdMask(toLocal[countr_zero(mask)]);
+    }
+    int listed = 0;
+    for (uint8_t id : record.listedMuscles()) {
+        if (toLocal[id] >= 0) ex.muscleIds[listed++] = toLocal[id];
+    }
+    ex.muscleCount = listed;
+    return ex;
+}
+
+shared_ptr<const ExerciseCatalog> loadSnapshot(const string& filename) {
+    auto file = make_shared<const MappedFile>(filename);
+    if (!file->data()) {
+        cerr << "File failed to open " << filename << endl;
+        return nullptr;
+    }
+
+    SnapshotHeader header;
+    if (file->size() < sizeof(header)) {
+        cerr << "Error: Invalid snapshot: " << filename << endl;
+        return nullptr;
+    }
+    memcpy(&header, file->data(), sizeof(header));
+    if (memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0) {
+        cerr << "Error: Invalid snapshot: " << filename << endl;
+        return nullptr;
+    }
+    if (header.version != SNAPSHOT_VERSION) {
+        cerr << "Error: Snapshot version " << header.version << " is not supported, expected "
+             << SNAPSHOT_VERSION << endl;
+        return nullptr;
+    }
+    if (header.byteOrder != SNAPSHOT_BYTE_ORDER || header.recordSize != sizeof(Exercise)) {
+        cerr << "Error: Snapshot was written on a different kind of machine, compile it again here: "
+             << filename << endl;
+        return nullptr;
+    }
+
+    size_t size = file->size();
+    if (!inFile(header.muscleOffset, header.muscleCount, sizeof(SnapshotString), size) ||
+        !inFile(header.equipmentOffset, header.equipmentCount, sizeof(SnapshotString), size) ||
+        !inFile(header.namePoolOffset, header.namePoolSize, 1, size) ||
+        !inFile(header.recordOffset, header.exerciseCount, sizeof(Exercise), size) ||
+        !inFile(header.optionOffset, header.optionCount, sizeof(EquipmentMask), size) ||
+        !inFile(header.textOffset, header.textSize, 1, size)) {
+        cerr << "Error: Snapshot is truncated: " << filename << endl;
+        return nullptr;
+    }
+
+    const char* base = file->data();
+    bool valid = header.muscleCount <= MAX_MUSCLES && header.equipmentCount <= EquipmentVocab::MAX_BITS &&
+                 header.textSize >= sizeof(uint32_t) && header.textSize <= UINT32_MAX;
+    for (uint64_t offset : {header.muscleOffset, header.equipmentOffset, header.recordOffset, header.optionOffset}) {
+        if ((uintptr_t)(base + offset) % alignof(uint64_t) != 0) valid = false;
+    }
+    if (!valid) {
+        cerr << "Error: Snapshot is corrupt: " << filename << endl;
+        return nullptr;
+    }
+
+    auto muscles = (const SnapshotString*)(base + header.muscleOffset);
+    auto equipment = (const SnapshotString*)(base + header.equipmentOffset);
+    const char* records = base + header.recordOffset;
+    auto options = span<const EquipmentMask>((const EquipmentMask*)(base + header.optionOffset), header.optionCount);
+    const char* pool = base + header.namePoolOffset;
+
+    auto name = [&](SnapshotString ref) {
+        if ((uint64_t)ref.offset + ref.length > header.namePoolSize) {
+            valid = false;
+            return string();
+        }
+        return string(pool + ref.offset, ref.length);
+    };
+
+    //the muscle table is shared by the whole process, so names only go into it once everything
+    //else in the file checked out
+    vector<string> muscleNames(header.muscleCount);
+    for (uint32_t i = 0; i < header.muscleCount; i++) {
+        muscleNames[i] = name(muscles[i]);
+    }
+
+    EquipmentVocab vocab;
+    for (uint32_t i = 0; i < header.equipmentCount; i++) {
+        if (vocab.intern(name(equipment[i])) != (int)i) valid = false;
+    }
+
+    ExerciseStore store = ExerciseStore::borrow(string_view(base + header.textOffset, header.textSize), options);
+    for (uint32_t i = 0; i < header.exerciseCount && valid; i++) {
+        if (!validRecord(records + (size_t)i * sizeof(Exercise), header, store)) valid = false;
+    }
+
+    if (!valid) {
+        cerr << "Error: Snapshot is corrupt: " << filename << endl;
+        return nullptr;
+    }
+
+    //snapshot muscle ids to the ids of this process, they only differ when another catalog added
+    //names past the known ones first
+    vector<int> toLocal(header.muscleCount);
+    bool sameIds = true;
+    for (uint32_t i = 0; i < header.muscleCount; i++) {
+        toLocal[i] = internMuscle(muscleNames[i]);
+        if (toLocal[i] != (int)i) sameIds = false;
+    }
+
+    cout << "Loaded " << header.exerciseCount << " exercises from snapshot.\n";
+    auto mapped = span<const Exercise>((const Exercise*)records, header.exerciseCount);
+    if (sameIds) {
+        return make_shared<const ExerciseCatalog>(mapped, move(vocab), move(store), file);
+    }
+
+    //only the muscle ids change, the text and options are still read from the file
+    vector<Exercise> exercises;
+    exercises.reserve(mapped.size());
+    for (const Exercise& record : mapped) {
+        exercises.push_back(remapMuscles(record, toLocal));
+    }
+    return make_shared<const ExerciseCatalog>(move(exercises), move(vocab), move(store), file);
+}
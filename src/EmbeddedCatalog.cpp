@@ -0,0 +1,192 @@
+//Catalog that is compiled into the program so it starts without reading any files
+#include "EmbeddedCatalog.h"
+#include <fstream>
+#include <iostream>
+#include <cstring>
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <bit>
+
+#ifdef SWP_EMBEDDED_CATALOG
+#include "EmbeddedCatalogData.inc"
+
+bool hasEmbeddedCatalog() {
+    return true;
+}
+
+//the pool strings one after another, each behind its length in this machine's byte order like
+//ExerciseStore::addText writes them. Built by the compiler so the text sits in read only data.
+static constexpr array<char, EMBEDDED_TEXT_SIZE> embeddedText() {
+    array<char, EMBEDDED_TEXT_SIZE> text{};
+    size_t at = 0;
+    for (string_view entry : EMBEDDED_STRINGS) {
+        uint32_t length = entry.size();
+        for (size_t b = 0; b < sizeof(length); b++) {
+            size_t shift = 8 * (endian::native == endian::little ? b : sizeof(length) - 1 - b);
+            text[at++] = char((length >> shift) & 0xff);
+        }
+        for (char c : entry) {
+            text[at++] = c;
+        }
+    }
+    return text;
+}
+
+static constexpr array<char, EMBEDDED_TEXT_SIZE> EMBEDDED_TEXT = embeddedText();
+
+//the rows as Exercise records, also made by the compiler so the catalog reads them in place
+static constexpr array<Exercise, size(EMBEDDED_EXERCISES)> embeddedRecords() {
+    array<Exercise, size(EMBEDDED_EXERCISES)> records{};
+    for (size_t i = 0; i < records.size(); i++) {
+        const EmbeddedExercise& row = EMBEDDED_EXERCISES[i];
+        Exercise& ex = records[i];
+        ex.nameRef = row.nameRef;
+        ex.equipmentRef = row.equipmentRef;
+        ex.categoryRef = row.categoryRef;
+        ex.firstOption = row.firstOption;
+        ex.optionCount = row.optionCount;
+        ex.muscleMask = row.muscleMask;
+        ex.muscleCount = row.muscleCount;
+        for (uint8_t m = 0; m < row.muscleCount; m++) {
+            ex.muscleIds[m] = EMBEDDED_MUSCLE_IDS[row.firstMuscle + m];
+        }
+        ex.estimatedDurationMinutes = row.duration;
+        ex.isCompound = row.compound;
+    }
+    return records;
+}
+
+static constexpr array<Exercise, size(EMBEDDED_EXERCISES)> EMBEDDED_RECORDS = embeddedRecords();
+
+//The records, text and options are all read only data. Only the equipment vocab, the catalog
+//itself and its indexes are made on first use.
+shared_ptr<const ExerciseCatalog> embeddedCatalog() {
+    static const shared_ptr<const ExerciseCatalog> catalog = [] {
+        //equipment names are stored in id order so the option masks stay valid
+        EquipmentVocab vocab;
+        for (const char* name : EMBEDDED_EQUIPMENT) {
+            vocab.intern(name);
+        }
+
+        ExerciseStore store = ExerciseStore::borrow(string_view(EMBEDDED_TEXT.data(), EMBEDDED_TEXT.size()),
+                                                    span<const EquipmentMask>(EMBEDDED_OPTIONS));
+        return make_shared<const ExerciseCatalog>(span<const Exercise>(EMBEDDED_RECORDS), move(vocab),
+                                                  move(store), nullptr);
+    }();
+    return catalog;
+}
+
+#else
+
+bool hasEmbeddedCatalog() {
+    return false;
+}
+
+shared_ptr<const ExerciseCatalog> embeddedCatalog() {
+    return nullptr;
+}
+
+#endif
+
+//C++ string literal with quotes and backslashes escaped
+static string quote(const string& text) {
+    string result = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            result += '\\';
+            result += c;
+        } else if ((unsigned char)c < 0x20) {
+            char escaped[8];
+            snprintf(escaped, sizeof(escaped), "\\%03o", (unsigned char)c);
+            result += escaped;
+        } else {
+            result += c;
+        }
+    }
+    return result + "\"";
+}
+
+static const char* muscleEnumNames[KNOWN_MUSCLES] = {
+    "MUSCLE_CHEST", "MUSCLE_BACK", "MUSCLE_SHOULDERS", "MUSCLE_BICEPS", "MUSCLE_TRICEPS",
+    "MUSCLE_QUADS", "MUSCLE_HAMSTRINGS", "MUSCLE_GLUTES", "MUSCLE_CALVES", "MUSCLE_CORE",
+    "MUSCLE_CARDIO", "MUSCLE_FULL_BODY", "MUSCLE_HIP_FLEXORS", "MUSCLE_OBLIQUES",
+    "MUSCLE_ARMS", "MUSCLE_LEGS"
+};
+
+bool writeEmbeddedCatalog(const ExerciseCatalog& catalog, const string& filename) {
+    for (size_t i = 0; i < catalog.size(); i++) {
+        const Exercise& ex = catalog.get(i);
+        for (uint8_t id : ex.listedMuscles()) {
+            if (id >= KNOWN_MUSCLES) {
+                cerr << "Error: Muscle group " << muscleName(id) << " can't be embedded." << endl;
+                return false;
+            }
+        }
+        if (ex.optionCount > UINT8_MAX || ex.estimatedDurationMinutes > UINT8_MAX) {
+            cerr << "Error: Exercise " << catalog.view(i).name() << " is too big to embed." << endl;
+            return false;
+        }
+    }
+
+    ofstream out(filename, ios::trunc);
+    if (!out.is_open()) {
+        cerr << "Error: Could not write file: " << filename << endl;
+        return false;
+    }
+
+    out << "//Generated by planner --embed-catalog, do not edit by hand\n\n";
+
+    const EquipmentVocab& vocab = catalog.getEquipmentVocab();
+    out << "constexpr const char* EMBEDDED_EQUIPMENT[] = {\n";
+    for (size_t id = 0; id < vocab.size(); id++) {
+        out << "    " << quote(vocab.name(id)) << ",\n";
+    }
+    out << "};\n\n";
+
+    //the store's text as it is, so the refs of the exercises stay valid
+    string_view text = catalog.getStore().textData();
+    out << "constexpr size_t EMBEDDED_TEXT_SIZE = " << text.size() << ";\n\n";
+    out << "constexpr string_view EMBEDDED_STRINGS[] = {\n";
+    for (size_t at = 0; at < text.size();) {
+        uint32_t length;
+        memcpy(&length, text.data() + at, sizeof(length));
+        string_view entry = text.substr(at + sizeof(length), length);
+        out << "    {" << quote(string(entry)) << ", " << length << "},\n";
+        at += sizeof(length) + length;
+    }
+    out << "};\n\n";
+
+    out << "constexpr uint8_t EMBEDDED_MUSCLE_IDS[] = {\n";
+    for (const Exercise& ex : catalog.getExercises()) {
+        out << "   ";
+        for (uint8_t id : ex.listedMuscles()) {
+            out << " " << muscleEnumNames[id] << ",";
+        }
+        out << "\n";
+    }
+    out << "};\n\n";
+
+    out << "constexpr EquipmentMask EMBEDDED_OPTIONS[] = {\n";
+    for (EquipmentMask option : catalog.getStore().allOptions()) {
+        out << "    0x" << hex << option << dec << "ull,\n";
+    }
+    out << "};\n\n";
+
+    out << "constexpr EmbeddedExercise EMBEDDED_EXERCISES[] = {\n";
+    uint32_t firstMuscle = 0;
+    for (const Exercise& ex : catalog.getExercises()) {
+        out << "    {" << ex.nameRef << ", " << ex.equipmentRef << ", " << ex.categoryRef << ", " << ex.firstOption
+            << ", 0x" << hex << ex.muscleMask << dec << ", " << firstMuscle << ", " << (int)ex.muscleCount
+            << ", " << ex.optionCount << ", " << ex.estimatedDurationMinutes
+            << ", " << (ex.isCompound ? "true" : "false") << "},\n";
+        firstMuscle += ex.muscleCount;
+    }
+    out << "};\n";
+
+    if (!out) {
+        cerr << "Error: Could not write file: " << filename << endl;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,130 @@
+//Parses the equipment text of each exercise once at load time so checking a user's equipment
+//is just a few mask compares instead of string searches
+#include "Equipment.h"
+#include <algorithm>
+#include <cctype>
+
+EquipmentVocab::EquipmentVocab() {
+    intern("Bodyweight");
+}
+
+//lowercase, single spaces and no plural s so "Dumbbells" and "dumbbell" are the same item
+string EquipmentVocab::normalize(const string& name) {
+    string result;
+    for (char c : name) {
+        if (isspace((unsigned char)c)) {
+            if (!result.empty() && result.back() != ' ') result += ' ';
+        } else {
+            result += (char)tolower((unsigned char)c);
+        }
+    }
+    if (!result.empty() && result.back() == ' ') result.pop_back();
+
+    if (result.size() > 3 && result.back() == 's' && result[result.size()-2] != 's') {
+        result.pop_back();
+    }
+    return result;
+}
+
+int EquipmentVocab::intern(const string& name) {
+    string key = normalize(name);
+    auto it = ids.find(key);
+    if (it != ids.end()) return it->second;
+
+    if ((int)names.size() == MAX_BITS) {
+        overflow = true;
+        return -1;
+    }
+    int id = (int)names.size();
+    names.push_back(key);
+    ids[key] = id;
+    return id;
+}
+
+EquipmentMask EquipmentVocab::bit(int id) {
+    return EquipmentMask(1) << id;
+}
+
+bool EquipmentVocab::overflowed() const {
+    return overflow;
+}
+
+//splits the text on a separator word like "+", "/" or "or"
+static vector<string> splitOn(const string& text, const string& sep) {
+    vector<string> parts;
+    size_t start = 0;
+    while (true) {
+        size_t pos = text.find(sep, start);
+        if (pos == string::npos) {
+            parts.push_back(text.substr(start));
+            break;
+        }
+        parts.push_back(text.substr(start, pos - start));
+        start = pos + sep.size();
+    }
+    return parts;
+}
+
+//"+" binds loosest, so "Box + Dumbbells / Bodyweight" is a box plus either dumbbells or bodyweight
+EquipmentReq EquipmentVocab::parse(const string& text) {
+    EquipmentReq req;
+    req.options.push_back(0);
+
+    for (const string& group : splitOn(text, "+")) {
+        vector<EquipmentMask> anyOf;
+        for (const string& slashPart : splitOn(group, "/")) {
+            for (const string& item : splitOn(slashPart, " or ")) {
+                if (normalize(item).empty()) continue;
+                int id = intern(item);
+                //the vocab is overflowed now and whoever loads the catalog fails it
+                if (id < 0) continue;
+                anyOf.push_back(bit(id));
+            }
+        }
+        if (anyOf.empty()) continue;
+
+        //expands to DNF, every current option gets one of the alternatives
+        vector<EquipmentMask> expanded;
+        for (EquipmentMask option : req.options) {
+            for (EquipmentMask alt : anyOf) {
+                expanded.push_back(option | alt);
+            }
+        }
+        req.options = move(expanded);
+    }
+    return req;
+}
+
+//true if b is a whole word suffix of a ("cable row machine" ends with "machine")
+static bool endsWithWord(const string& a, const string& b) {
+    if (b.size() >= a.size()) return false;
+    return a.compare(a.size() - b.size(), b.size(), b) == 0 && a[a.size() - b.size() - 1] == ' ';
+}
+
+EquipmentMask EquipmentVocab::ownedMask(const unordered_set<string>& owned) const {
+    EquipmentMask mask = bit(BODYWEIGHT);
+    for (const string& item : owned) {
+        mask |= itemMask(item);
+    }
+    return mask;
+}
+
+EquipmentMask EquipmentVocab::itemMask(const string& item) const {
+    EquipmentMask mask = 0;
+    string key = normalize(item);
+    for (int id = 0; id < (int)names.size(); id++) {
+        const string& name = names[id];
+        if (name == key || endsWithWord(name, key) || endsWithWord(key, name)) {
+            mask |= bit(id);
+        }
+    }
+    return mask;
+}
+
+size_t EquipmentVocab::size() const {
+    return names.size();
+}
+
+const string& EquipmentVocab::name(int id) const {
+    return names.at(id);
+}
@@ -3,50 +3,65 @@
 #include "Exercise.h"
 #include <algorithm>
 
-Exercise::Exercise(string n, vector<string> muscles, string equip, bool compound, int duration)
-    : name(move(n)),muscleGroups(move(muscles)),equipment(move(equip)),
-      isCompound(compound),estimatedDurationMinutes(duration) {}
-
-void Exercise::display() const {
-    cout << name << " | ";
-    for(const auto& m:muscleGroups)cout<<m<< " ";
-    cout << "| " << equipment << " | Compound: " << (isCompound ? "Yes" : "No")
-         << " | Duration: "<<estimatedDurationMinutes<<"min\n";
+Exercise::Exercise(ExerciseStore& store, string_view n, const vector<string>& muscles, string_view equip,
+                   bool compound, int duration)
+    : nameRef(store.addText(n)), equipmentRef(store.addText(equip)),
+      estimatedDurationMinutes((uint16_t)clamp(duration, 0, 0xFFFF)), isCompound(compound) {
+    //exercises come from a catalog, so this is where new muscle names get their ids
+    for (const string& muscle : muscles) {
+        int id=internMuscle(muscle);
+        if (id<0) continue;
+        muscleMask|=muscleIdMask(id);
+        if (muscleCount<MAX_LISTED_MUSCLES) muscleIds[muscleCount++]=(uint8_t)id;
+    }
 }
 
 //Creates exercise from JSON data which has over 100 workouts
-Exercise Exercise::from_json(const json& j) {
+Exercise Exercise::from_json(const json& j, EquipmentVocab& vocab, ExerciseStore& store) {
     vector<string> muscles=j["muscle_groups"];
     string exerciseName=j["exercise"];
     string equipmentName=j["equipment"];
     bool compound=muscles.size()>=2;  // compound if targets multiple muscles
     int duration=5;
 
-    Exercise ex(exerciseName, muscles, equipmentName, compound, duration);
-    ex.equipmentCategory=j.value("equipmentCategory", "");
+    Exercise ex(store, exerciseName, muscles, equipmentName, compound, duration);
+    ex.categoryRef=store.addText(j.value("equipmentCategory", ""));
+    EquipmentReq req=vocab.parse(equipmentName);
+    ex.firstOption=store.addOptions(req.options);
+    ex.optionCount=(uint16_t)min<size_t>(req.options.size(), 0xFFFF);
     return ex;
 }
 
 // Checks if exercise works with any of the target muscles
 bool Exercise::targetsAnyMuscle(const vector<string>& targetMuscles) const {
-    for(const string& muscle : muscleGroups) {
-        if(find(targetMuscles.begin(), targetMuscles.end(), muscle)!=targetMuscles.end()) {
-            return true;
-        }
+    return targetsAnyMuscle(muscleMaskOf(targetMuscles));
+}
+
+vector<string> ExerciseView::muscleGroups() const {
+    vector<string> names;
+    for (uint8_t id : record->listedMuscles()) {
+        names.push_back(muscleName(id));
     }
-    return false;
+    return names;
+}
+
+void ExerciseView::display() const {
+    cout << name() << " | ";
+    for (uint8_t id : record->listedMuscles()) cout << muscleName(id) << " ";
+    cout << "| " << equipment() << " | Compound: " << (record->isCompound ? "Yes" : "No")
+         << " | Duration: "<<record->estimatedDurationMinutes<<"min\n";
 }
 
-bool Exercise::requiresEquipment(const string& equip) const {
-    return equipment.find(equip)!=string::npos;
+bool ExerciseView::requiresEquipment(const string& equip) const {
+    return equipment().find(equip)!=string_view::npos;
 }
 
-json Exercise::to_json() const {
+json ExerciseView::to_json() const {
     return json{
-                {"exercise", name},
-                {"muscle_groups", muscleGroups},
-                {"equipment", equipment},
-                {"is_compound", isCompound},
-                {"duration_minutes", estimatedDurationMinutes}
+                {"exercise", name()},
+                {"muscle_groups", muscleGroups()},
+                {"equipment", equipment()},
+                {"is_compound", record->isCompound},
+                {"duration_minutes", record->estimatedDurationMinutes}
     };
 }
\ No newline at end of file
@@ -0,0 +1,175 @@
+//Read only exercise database shared by all plan requests
+#include "ExerciseCatalog.h"
+#include "CatalogLoader.h"
+#include <fstream>
+#include <iostream>
+#include <bit>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+
+ExerciseCatalog::ExerciseCatalog(vector<Exercise> exs, EquipmentVocab vocab, ExerciseStore exerciseStore,
+                                 shared_ptr<const void> owner)
+    : ownedExercises(move(exs)), store(move(exerciseStore)), backing(move(owner)), equipmentVocab(move(vocab)) {
+    ownedExercises.shrink_to_fit();
+    exercises = ownedExercises;
+    store.seal();
+    table = ExerciseTable(exercises, store);
+    buildIndexes();
+}
+
+ExerciseCatalog::ExerciseCatalog(span<const Exercise> records, EquipmentVocab vocab, ExerciseStore exerciseStore,
+                                 shared_ptr<const void> owner)
+    : exercises(records), store(move(exerciseStore)), backing(move(owner)), equipmentVocab(move(vocab)),
+      table(exercises, store) {
+    store.seal();
+    buildIndexes();
+}
+
+//exercises are added in index order so every list comes out sorted
+void ExerciseCatalog::buildIndexes() {
+    unordered_map<EquipmentMask, size_t> optionSlot;
+    for (uint32_t i = 0; i < exercises.size(); i++) {
+        const Exercise& ex = exercises[i];
+        for (MuscleMask m = ex.muscleMask; m; m &= m - 1) {
+            muscleIndex[countr_zero(m)].push_back(i);
+        }
+        for (EquipmentMask option : as_const(store).options(ex.firstOption, ex.optionCount)) {
+            auto [it, added] = optionSlot.try_emplace(option, equipmentIndex.size());
+            if (added) equipmentIndex.push_back({option, {}});
+            PostingList& list = equipmentIndex[it->second].second;
+            //two options can be the same mask after normalizing
+            if (list.empty() || list.back() != i) list.push_back(i);
+        }
+        if (ex.isCompound) compoundIndex.push_back(i);
+    }
+}
+
+ExerciseCatalog::~ExerciseCatalog() {
+    for (auto& slot : pools) {
+        delete slot.load(memory_order_acquire);
+    }
+}
+
+shared_ptr<const ExerciseCatalog> ExerciseCatalog::load(const string& filename) {
+    ifstream file(filename);
+    if (!file.is_open()) {
+        cerr << "File failed to open "<<filename<<endl;
+        return nullptr;
+    }
+
+    //streams the array so only one exercise is held as JSON at a time
+    vector<Exercise> exercises;
+    EquipmentVocab vocab;
+    ExerciseStore store;
+    bool ok=streamExercises(file, vocab, store, [&exercises](Exercise&& ex) {
+        exercises.push_back(move(ex));
+    });
+    if (!ok) return nullptr;
+
+    cout <<"Loaded " << exercises.size() << " exercises from file.\n";
+    return make_shared<const ExerciseCatalog>(move(exercises), move(vocab), move(store));
+}
+
+span<const Exercise> ExerciseCatalog::getExercises() const {
+    return exercises;
+}
+
+const Exercise& ExerciseCatalog::get(size_t index) const {
+    return exercises[index];
+}
+
+ExerciseView ExerciseCatalog::view(size_t index) const {
+    return ExerciseView(exercises[index], store);
+}
+
+const ExerciseStore& ExerciseCatalog::getStore() const {
+    return store;
+}
+
+const EquipmentVocab& ExerciseCatalog::getEquipmentVocab() const {
+    return equipmentVocab;
+}
+
+const ExerciseTable& ExerciseCatalog::getTable() const {
+    return table;
+}
+
+const PostingList& ExerciseCatalog::muscleExercises(int muscle) const {
+    return muscleIndex.at(muscle);
+}
+
+PostingList ExerciseCatalog::muscleExercises(MuscleMask muscles) const {
+    vector<const PostingList*> lists;
+    for (MuscleMask m = muscles; m; m &= m - 1) {
+        lists.push_back(&muscleIndex[countr_zero(m)]);
+    }
+    return unionPostings(lists);
+}
+
+PostingList ExerciseCatalog::equipmentExercises(EquipmentMask owned) const {
+    vector<const PostingList*> lists;
+    for (const auto& [option, list] : equipmentIndex) {
+        if ((owned & option) == option) lists.push_back(&list);
+    }
+    return unionPostings(lists);
+}
+
+const PostingList& ExerciseCatalog::compoundExercises() const {
+    return compoundIndex;
+}
+
+PostingList ExerciseCatalog::query(MuscleMask muscles, EquipmentMask owned, bool compoundOnly) const {
+    PostingList result = equipmentExercises(owned);
+    if (muscles) result = intersectPostings(result, muscleExercises(muscles));
+    if (compoundOnly) result = intersectPostings(result, compoundIndex);
+    return result;
+}
+
+unique_ptr<EligiblePool> ExerciseCatalog::buildPool(EquipmentMask owned) const {
+    auto pool = make_unique<EligiblePool>();
+    pool->owned = owned;
+    pool->exercises = equipmentExercises(owned);
+    pool->compounds = intersectPostings(pool->exercises, compoundIndex);
+    for (int m = 0; m < MAX_MUSCLES; m++) {
+        if (!muscleIndex[m].empty()) {
+            pool->byMuscle[m] = intersectPostings(pool->exercises, muscleIndex[m]);
+        }
+    }
+    return pool;
+}
+
+const EligiblePool& ExerciseCatalog::eligiblePool(EquipmentMask owned, shared_ptr<const EligiblePool>& storage) const {
+    size_t start = hash<EquipmentMask>{}(owned) % POOL_SLOTS;
+
+    //fast path, the pool is already there
+    for (size_t probe = 0; probe < POOL_SLOTS; probe++) {
+        EligiblePool* pool = pools[(start + probe) % POOL_SLOTS].load(memory_order_acquire);
+        if (!pool) break;
+        if (pool->owned == owned) return *pool;
+    }
+
+    //builds it and claims the first empty slot, if another thread got there first its pool is used
+    unique_ptr<EligiblePool> fresh = buildPool(owned);
+    for (size_t probe = 0; probe < POOL_SLOTS; probe++) {
+        atomic<EligiblePool*>& slot = pools[(start + probe) % POOL_SLOTS];
+        EligiblePool* expected = nullptr;
+        if (slot.compare_exchange_strong(expected, fresh.get(), memory_order_acq_rel)) {
+            return *fresh.release();
+        }
+        if (expected->owned == owned) {
+            return *expected;
+        }
+    }
+
+    storage = move(fresh);
+    return *storage;
+}
+
+size_t ExerciseCatalog::size() const {
+    return exercises.size();
+}
+
+bool ExerciseCatalog::empty() const {
+    return exercises.empty();
+}
@@ -0,0 +1,89 @@
+//Shared storage behind the compact exercise records
+#include "ExerciseStore.h"
+#include "Exercise.h"
+#include <cstring>
+#include <functional>
+
+ExerciseStore::ExerciseStore() {
+    addText("");
+}
+
+ExerciseStore ExerciseStore::borrow(string_view textData, span<const EquipmentMask> options) {
+    ExerciseStore store;
+    store.chars.clear();
+    store.lookup.clear();
+    store.borrowedChars = textData;
+    store.borrowedOptions = options;
+    return store;
+}
+
+uint32_t ExerciseStore::addText(string_view text) {
+    size_t hash = std::hash<string_view>{}(text);
+    auto [first, last] = lookup.equal_range(hash);
+    for (auto it = first; it != last; ++it) {
+        if (this->text(it->second) == text) return it->second;
+    }
+
+    uint32_t ref = (uint32_t)chars.size();
+    uint32_t length = (uint32_t)text.size();
+    chars.append((const char*)&length, sizeof(length));
+    chars.append(text);
+    lookup.emplace(hash, ref);
+    return ref;
+}
+
+string_view ExerciseStore::text(uint32_t ref) const {
+    string_view all = textData();
+    uint32_t length;
+    memcpy(&length, all.data() + ref, sizeof(length));
+    return string_view(all.data() + ref + sizeof(length), length);
+}
+
+bool ExerciseStore::validText(uint32_t ref) const {
+    string_view all = textData();
+    if (all.size() < sizeof(uint32_t) || ref > all.size() - sizeof(uint32_t)) return false;
+    uint32_t length;
+    memcpy(&length, all.data() + ref, sizeof(length));
+    return length <= all.size() - sizeof(uint32_t) - ref;
+}
+
+uint32_t ExerciseStore::addOptions(span<const EquipmentMask> options) {
+    uint32_t first = (uint32_t)optionList.size();
+    optionList.insert(optionList.end(), options.begin(), options.end());
+    return first;
+}
+
+span<const EquipmentMask> ExerciseStore::options(uint32_t first, uint32_t count) const {
+    return allOptions().subspan(first, count);
+}
+
+span<EquipmentMask> ExerciseStore::options(uint32_t first, uint32_t count) {
+    return span<EquipmentMask>(optionList).subspan(first, count);
+}
+
+string_view ExerciseStore::textData() const {
+    return borrowedChars.empty() ? string_view(chars) : borrowedChars;
+}
+
+span<const EquipmentMask> ExerciseStore::allOptions() const {
+    return borrowedChars.empty() ? span<const EquipmentMask>(optionList) : borrowedOptions;
+}
+
+Exercise ExerciseStore::import(const Exercise& ex, const ExerciseStore& from) {
+    Exercise copy = ex;
+    copy.nameRef = addText(from.text(ex.nameRef));
+    copy.equipmentRef = addText(from.text(ex.equipmentRef));
+    copy.categoryRef = addText(from.text(ex.categoryRef));
+    copy.firstOption = addOptions(from.options(ex.firstOption, ex.optionCount));
+    return copy;
+}
+
+void ExerciseStore::seal() {
+    lookup = {};
+    chars.shrink_to_fit();
+    optionList.shrink_to_fit();
+}
+
+size_t ExerciseStore::bytes() const {
+    return chars.capacity() + optionList.capacity() * sizeof(EquipmentMask);
+}
@@ -0,0 +1,142 @@
+//Column store of the catalog for filters that have to look at every exercise
+#include "ExerciseTable.h"
+#include <bit>
+#include <cstring>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+ExerciseTable::ExerciseTable(span<const Exercise> exercises, const ExerciseStore& store) {
+    size_t count = exercises.size();
+    muscleColumn.reserve(count);
+    equipmentColumn.reserve(count);
+    flagColumn.reserve(count);
+    durationColumn.reserve(count);
+    optionOffsets.reserve(count + 1);
+
+    for (const Exercise& ex : exercises) {
+        span<const EquipmentMask> reqOptions = store.options(ex.firstOption, ex.optionCount);
+        uint8_t flags = ex.isCompound ? COMPOUND : 0;
+        if (reqOptions.size() != 1) flags |= MULTI_OPTION;
+
+        muscleColumn.push_back(ex.muscleMask);
+        //never matches on its own, MULTI_OPTION rows are checked against their options
+        equipmentColumn.push_back(reqOptions.size() == 1 ? reqOptions[0] : ~EquipmentMask(0));
+        flagColumn.push_back(flags);
+        durationColumn.push_back(ex.estimatedDurationMinutes);
+
+        optionOffsets.push_back((uint32_t)options.size());
+        options.insert(options.end(), reqOptions.begin(), reqOptions.end());
+    }
+    optionOffsets.push_back((uint32_t)options.size());
+}
+
+size_t ExerciseTable::size() const {
+    return muscleColumn.size();
+}
+
+MuscleMask ExerciseTable::muscles(size_t row) const {
+    return muscleColumn[row];
+}
+
+bool ExerciseTable::optionsSatisfied(size_t row, EquipmentMask owned) const {
+    for (uint32_t i = optionOffsets[row]; i < optionOffsets[row + 1]; i++) {
+        if ((owned & options[i]) == options[i]) return true;
+    }
+    return false;
+}
+
+bool ExerciseTable::canDo(size_t row, EquipmentMask owned) const {
+    if (flagColumn[row] & MULTI_OPTION) return optionsSatisfied(row, owned);
+    return (owned & equipmentColumn[row]) == equipmentColumn[row];
+}
+
+bool ExerciseTable::isCompound(size_t row) const {
+    return flagColumn[row] & COMPOUND;
+}
+
+int ExerciseTable::duration(size_t row) const {
+    return durationColumn[row];
+}
+
+//everything except the exclude list, that is merged in while the selection is written
+bool ExerciseTable::rowMatches(size_t row, const TableFilter& filter) const {
+    if (filter.muscles && !(muscleColumn[row] & filter.muscles)) return false;
+    if (filter.compoundOnly && !(flagColumn[row] & COMPOUND)) return false;
+    return canDo(row, filter.owned);
+}
+
+void ExerciseTable::scanScalar(const TableFilter& filter, size_t begin, size_t end, vector<uint32_t>& selection) const {
+    for (size_t row = begin; row < end; row++) {
+        if (rowMatches(row, filter)) selection.push_back((uint32_t)row);
+    }
+}
+
+#ifdef __AVX2__
+//Four rows per step. The equipment and muscle checks are two compares on 64 bit lanes, rows with
+//several options come out of the vector part as a second mask and get checked one by one.
+void ExerciseTable::scanAvx2(const TableFilter& filter, vector<uint32_t>& selection) const {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i owned = _mm256_set1_epi64x((long long)filter.owned);
+    const __m256i muscles = _mm256_set1_epi64x(filter.muscles);
+    const __m256i compound = _mm256_set1_epi64x(COMPOUND);
+    const __m256i multi = _mm256_set1_epi64x(MULTI_OPTION);
+
+    size_t count = size();
+    size_t row = 0;
+    for (; row + 4 <= count; row += 4) {
+        __m256i equipment = _mm256_loadu_si256((const __m256i*)&equipmentColumn[row]);
+        __m256i missing = _mm256_andnot_si256(owned, equipment);
+        __m256i keep = _mm256_cmpeq_epi64(missing, zero);
+
+        if (filter.muscles) {
+            __m256i rowMuscles = _mm256_cvtepu32_epi64(_mm_loadu_si128((const __m128i*)&muscleColumn[row]));
+            __m256i noneHit = _mm256_cmpeq_epi64(_mm256_and_si256(rowMuscles, muscles), zero);
+            keep = _mm256_andnot_si256(noneHit, keep);
+        }
+
+        uint32_t packedFlags;
+        memcpy(&packedFlags, &flagColumn[row], sizeof(packedFlags));
+        __m256i flags = _mm256_cvtepu8_epi64(_mm_cvtsi32_si128((int)packedFlags));
+        if (filter.compoundOnly) {
+            __m256i notCompound = _mm256_cmpeq_epi64(_mm256_and_si256(flags, compound), zero);
+            keep = _mm256_andnot_si256(notCompound, keep);
+        }
+
+        int hits = _mm256_movemask_pd(_mm256_castsi256_pd(keep));
+        int special = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(_mm256_and_si256(flags, multi), zero)));
+        if (special) {
+            hits &= ~special;
+            for (int lane = 0; lane < 4; lane++) {
+                if ((special >> lane & 1) && rowMatches(row + lane, filter)) hits |= 1 << lane;
+            }
+        }
+        for (; hits; hits &= hits - 1) {
+            selection.push_back((uint32_t)(row + countr_zero((unsigned)hits)));
+        }
+    }
+    scanScalar(filter, row, count, selection);
+}
+#endif
+
+vector<uint32_t> ExerciseTable::scan(const TableFilter& filter) const {
+    vector<uint32_t> selection;
+#ifdef __AVX2__
+    scanAvx2(filter, selection);
+#else
+    scanScalar(filter, 0, size(), selection);
+#endif
+
+    if (!filter.exclude.empty()) {
+        span<const uint32_t> exclude = filter.exclude;
+        size_t next = 0, kept = 0;
+        for (uint32_t row : selection) {
+            while (next < exclude.size() && exclude[next] < row) next++;
+            if (next < exclude.size() && exclude[next] == row) continue;
+            selection[kept++] = row;
+        }
+        selection.resize(kept);
+    }
+    return selection;
+}
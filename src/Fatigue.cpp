@@ -0,0 +1,73 @@
+//Muscle recovery over the week, replaces looking up what the day before trained by name
+#include "Fatigue.h"
+
+//longest recovery window in days, nothing trained this long ago is fatigued
+static constexpr int LONGEST_RECOVERY_DAYS = 3;
+
+int FatigueState::recoveryHours(int muscle) {
+    return (LOWER_BODY & muscleBit(muscle)) ? 72 : 48;
+}
+
+MuscleMask FatigueState::recoveringAfter(int days) {
+    static const auto masks = [] {
+        array<MuscleMask, LONGEST_RECOVERY_DAYS> result{};
+        for (int d = 0; d < LONGEST_RECOVERY_DAYS; d++) {
+            for (int m = 0; m < MAX_MUSCLES; m++) {
+                if (recoveryHours(m) > d * 24) result[d] |= muscleBit(m);
+            }
+        }
+        return result;
+    }();
+    return days >= 0 && days < LONGEST_RECOVERY_DAYS ? masks[days] : 0;
+}
+
+void FatigueState::train(Weekday day, MuscleMask muscles) {
+    if (day < MONDAY || day >= DAYS_IN_WEEK || !muscles) return;
+    thisWeek[day] |= muscles;
+    thisWeekDays |= dayBit(day);
+}
+
+void FatigueState::forget(Weekday day) {
+    if (day < MONDAY || day >= DAYS_IN_WEEK) return;
+    thisWeek[day] = 0;
+    thisWeekDays &= ~dayBit(day);
+}
+
+void FatigueState::nextWeek() {
+    lastWeek = thisWeek;
+    lastWeekDays = thisWeekDays;
+    thisWeek.fill(0);
+    thisWeekDays = 0;
+}
+
+void FatigueState::clear() {
+    thisWeek.fill(0);
+    lastWeek.fill(0);
+    thisWeekDays = lastWeekDays = 0;
+}
+
+MuscleMask FatigueState::fatigued(Weekday day) const {
+    if (day < MONDAY || day >= DAYS_IN_WEEK) return 0;
+    //the seven days before this one: earlier days of this week, the rest from the week before
+    DayMask earlier = dayBit(day) - 1;
+    DayMask recent = (thisWeekDays & earlier) | (lastWeekDays & ~earlier & ALL_DAYS);
+
+    MuscleMask result = 0;
+    int trainedDay = day;
+    int gap = 0;
+    while (true) {
+        int step = restGap(recent, trainedDay);
+        if (!step) break;
+        gap += step;
+        if (gap >= LONGEST_RECOVERY_DAYS) break;
+        trainedDay = previousTrainingDay(recent, trainedDay);
+        MuscleMask trained = trainedDay < day ? thisWeek[trainedDay] : lastWeek[trainedDay];
+        result |= trained & recoveringAfter(gap);
+    }
+    return result;
+}
+
+MuscleMask FatigueState::trainedOn(Weekday day) const {
+    if (day < MONDAY || day >= DAYS_IN_WEEK) return 0;
+    return thisWeek[day];
+}
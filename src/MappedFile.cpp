@@ -0,0 +1,41 @@
+#include "MappedFile.h"
+#include <fstream>
+#include <iterator>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const string& filename) {
+#ifndef _WIN32
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) return;
+    struct stat info;
+    if (fstat(fd, &info) == 0 && info.st_size > 0) {
+        void* address = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address != MAP_FAILED) {
+            bytes = (const char*)address;
+            length = info.st_size;
+            mapped = true;
+        }
+    }
+    close(fd);
+#else
+    ifstream file(filename, ios::binary);
+    if (!file.is_open()) return;
+    buffer.assign(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+    if (!buffer.empty()) {
+        bytes = buffer.data();
+        length = buffer.size();
+    }
+#endif
+}
+
+MappedFile::~MappedFile() {
+#ifndef _WIN32
+    if (mapped) munmap((void*)bytes, length);
+#endif
+}
@@ -0,0 +1,89 @@
+//Muscle vocabulary so exercises can store their muscle groups as one mask
+#include "Muscle.h"
+#include <atomic>
+#include <mutex>
+#include <bit>
+#include <iostream>
+
+static array<string, MAX_MUSCLES> names = {
+    "Chest", "Back", "Shoulders", "Biceps", "Triceps", "Quads", "Hamstrings",
+    "Glutes", "Calves", "Core", "Cardio", "Full Body", "Hip Flexors", "Obliques",
+    "Arms", "Legs"
+};
+static atomic<int> nameCount{KNOWN_MUSCLES};
+static mutex internLock;
+static bool reportedFull = false;
+
+//names are only ever added, so anything below the count can be read without locking
+int muscleId(const string& name) {
+    int count = nameCount.load(memory_order_acquire);
+    for (int id = 0; id < count; id++) {
+        if (names[id] == name) return id;
+    }
+    return -1;
+}
+
+//A new name takes the lock once to get its id. A full table turns names away instead of letting
+//them share a bit with a muscle that is already in it.
+int internMuscle(const string& name) {
+    int id = muscleId(name);
+    if (id >= 0) return id;
+
+    lock_guard<mutex> guard(internLock);
+    int count = nameCount.load(memory_order_relaxed);
+    for (id = 0; id < count; id++) {
+        if (names[id] == name) return id;
+    }
+    if (count == MAX_MUSCLES) {
+        if (!reportedFull) {
+            cerr << "Error: Only " << MAX_MUSCLES << " muscle groups are supported, " << name
+                 << " and any other new ones are left out." << endl;
+            reportedFull = true;
+        }
+        return -1;
+    }
+
+    names[count] = name;
+    nameCount.store(count + 1, memory_order_release);
+    return count;
+}
+
+const string& muscleName(int id) {
+    return names.at(id);
+}
+
+MuscleMask muscleIdMask(int id) {
+    if (id < 0) return 0;
+    if (id == MUSCLE_ARMS) return ARM_MUSCLES;
+    if (id == MUSCLE_LEGS) return LEG_MUSCLES;
+    return muscleBit(id);
+}
+
+MuscleMask muscleMaskOf(const string& name) {
+    return muscleIdMask(muscleId(name));
+}
+
+MuscleMask muscleMaskOf(const vector<string>& names) {
+    MuscleMask mask = 0;
+    for (const string& name : names) {
+        mask |= muscleMaskOf(name);
+    }
+    return mask;
+}
+
+vector<string> muscleNames(MuscleMask mask) {
+    vector<string> result;
+    while (mask) {
+        int id = countr_zero(mask);
+        result.push_back(muscleName(id));
+        mask &= mask - 1;
+    }
+    return result;
+}
+
+void addMuscles(MuscleHistogram& histogram, MuscleMask mask) {
+    while (mask) {
+        histogram[countr_zero(mask)]++;
+        mask &= mask - 1;
+    }
+}
@@ -0,0 +1,101 @@
+#include "PlanCache.h"
+#include "PlanContext.h"
+#include <algorithm>
+
+PlanCache::PlanCache(size_t maxPlans) : capacity(max<size_t>(1, maxPlans)) {}
+
+//names are written as their length, ':' and the text, so a name with a separator in it can't make
+//two different users read as the same key
+static void appendName(string& key, const string& name) {
+    key += to_string(name.size());
+    key += ':';
+    key += name;
+}
+
+//height, weight, age, gender and name are left out since they don't change which exercises get picked
+string PlanCache::makeKey(const User& user, uint64_t seed) {
+    string key = "days:" + to_string(user.workoutDays);
+
+    vector<string> equipment(user.equipment.begin(), user.equipment.end());
+    sort(equipment.begin(), equipment.end());
+    key += "|equipment:" + to_string(equipment.size()) + ",";
+    for (const string& item : equipment) {
+        appendName(key, item);
+    }
+
+    key += "|priorities:" + to_string(user.priorities.size()) + ",";
+    for (const auto& [muscle, level] : user.priorities) {
+        appendName(key, muscle);
+        key += "=" + to_string((int)level) + ",";
+    }
+
+    key += "|goal:" + to_string((int)user.goal);
+    key += "|seed:" + to_string(seed);
+    return key;
+}
+
+vector<WorkoutSession> PlanCache::getPlan(const WorkoutPlanner& planner, const User& user, uint64_t seed) {
+    string key = makeKey(user, seed);
+    shared_ptr<const ExerciseCatalog> current = planner.getCatalog();
+
+    {
+        lock_guard<mutex> guard(lock);
+        if (current != catalog) {
+            clearLocked();
+            catalog = current;
+        }
+
+        auto it = index.find(key);
+        if (it != index.end()) {
+            hits++;
+            entries.splice(entries.begin(), entries, it->second);
+            vector<WorkoutSession> plan = it->second->plan;
+            for (WorkoutSession& session : plan) {
+                session.setUserWeight(user.weight);
+            }
+            return plan;
+        }
+        misses++;
+    }
+
+    //plans outside the lock so other requests aren't held up
+    PlanContext ctx(user, seed);
+    vector<WorkoutSession> plan = planner.makePlan(ctx);
+
+    lock_guard<mutex> guard(lock);
+    if (current != catalog || index.count(key)) return plan;
+
+    entries.push_front({key, plan});
+    index[key] = entries.begin();
+    if (entries.size() > capacity) {
+        index.erase(entries.back().key);
+        entries.pop_back();
+    }
+    return plan;
+}
+
+void PlanCache::clearLocked() {
+    entries.clear();
+    index.clear();
+}
+
+void PlanCache::invalidate() {
+    lock_guard<mutex> guard(lock);
+    clearLocked();
+    catalog = nullptr;
+}
+
+size_t PlanCache::size() {
+    lock_guard<mutex> guard(lock);
+    return entries.size();
+}
+
+uint64_t PlanCache::getHits() {
+    lock_guard<mutex> guard(lock);
+    return hits;
+}
+
+uint64_t PlanCache::getMisses() {
+    lock_guard<mutex> guard(lock);
+    return misses;
+}
@@ -0,0 +1,25 @@
+#include "PlanContext.h"
+
+PlanContext::PlanContext() : rng(random_device{}()) {}
+
+PlanContext::PlanContext(const User& u) : user(u), rng(random_device{}()) {}
+
+PlanContext::PlanContext(const User& u, uint64_t seed) : user(u), rng(seed) {}
+
+void PlanContext::reset() {
+    fatigue.clear();
+    exerciseCount.clear();
+    pool = nullptr;
+    poolStorage.reset();
+    underRepeatLimit.clear();
+    repeatPoolReady = false;
+    favored = 0;
+}
+
+ScratchArena& PlanContext::scratchArena() const {
+    return arena ? *arena : ScratchArena::forThread();
+}
+
+pmr::memory_resource* PlanContext::scratch() const {
+    return scratchArena().resource();
+}
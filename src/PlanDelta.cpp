@@ -0,0 +1,67 @@
+//Edits to a user's settings that the planner can apply to an existing plan
+#include "PlanDelta.h"
+#include <algorithm>
+#include <iostream>
+
+PlanDelta PlanDelta::addDay(Weekday day) {
+    return PlanDelta{.kind = DeltaKind::ADD_DAY, .day = day};
+}
+
+PlanDelta PlanDelta::removeDay(Weekday day) {
+    return PlanDelta{.kind = DeltaKind::REMOVE_DAY, .day = day};
+}
+
+PlanDelta PlanDelta::moveDay(Weekday from, Weekday to) {
+    return PlanDelta{.kind = DeltaKind::MOVE_DAY, .day = from, .toDay = to};
+}
+
+PlanDelta PlanDelta::setPriority(const string& muscle, Priority priority) {
+    return PlanDelta{.kind = DeltaKind::SET_PRIORITY, .muscle = muscle, .priority = priority};
+}
+
+PlanDelta PlanDelta::toggleEquipment(const string& equipment) {
+    return PlanDelta{.kind = DeltaKind::TOGGLE_EQUIPMENT, .equipment = equipment};
+}
+
+static string dayLabel(Weekday day) {
+    return day>=MONDAY && day<DAYS_IN_WEEK ? weekdayName(day) : "an unknown day";
+}
+
+bool applyDelta(User& user, const PlanDelta& delta) {
+    DayMask& days=user.workoutDays;
+    bool valid=delta.day>=MONDAY && delta.day<DAYS_IN_WEEK;
+    bool training=valid && (days & dayBit(delta.day));
+
+    switch (delta.kind) {
+        case DeltaKind::ADD_DAY:
+            if (!valid || training) {
+                cerr << "Can't add " << dayLabel(delta.day) << " to the workout days\n";
+                return false;
+            }
+            days|=dayBit(delta.day);
+            return true;
+        case DeltaKind::REMOVE_DAY:
+            if (!training) {
+                cerr << dayLabel(delta.day) << " is not a workout day\n";
+                return false;
+            }
+            days&=~dayBit(delta.day);
+            return true;
+        case DeltaKind::MOVE_DAY:
+            if (!training || delta.toDay<MONDAY || delta.toDay>=DAYS_IN_WEEK || (days & dayBit(delta.toDay))) {
+                cerr << "Can't move " << dayLabel(delta.day) << " to " << dayLabel(delta.toDay) << "\n";
+                return false;
+            }
+            days=(days & ~dayBit(delta.day)) | dayBit(delta.toDay);
+            return true;
+        case DeltaKind::SET_PRIORITY:
+            user.priorities[delta.muscle]=delta.priority;
+            return true;
+        case DeltaKind::TOGGLE_EQUIPMENT:
+            if (!user.equipment.erase(delta.equipment)) {
+                user.equipment.insert(delta.equipment);
+            }
+            return true;
+    }
+    return false;
+}
@@ -0,0 +1,136 @@
+//Anytime local search over a weekly plan, stops at a deadline with the best plan found so far
+#include "PlanOptimizer.h"
+#include <bit>
+#include <algorithm>
+#include <unordered_map>
+#include <memory_resource>
+#include <array>
+#include <cstddef>
+
+//score weights, a repeat or a duplicate costs more than any single exercise can add
+static const int FOCUS_BONUS = 4;
+static const int REPEAT_COST = 20;
+static const int DUPLICATE_COST = 50;
+static const int RECOVERY_COST = 3;
+static const int LOWER_RECOVERY_COST = 5;
+static const int MINUTE_COST = 10;
+
+PlanOptimizer::PlanOptimizer(const ExerciseCatalog& exerciseCatalog, const EligiblePool& eligible, const User& user,
+                             function<int(uint32_t)> exerciseTime, int minMinutes, int maxMinutes)
+    : catalog(exerciseCatalog), pool(eligible), timeOf(move(exerciseTime)), minTime(minMinutes), maxTime(maxMinutes) {
+    //LOW is 1, MEDIUM 2 and HIGH 3, muscles the user didn't rate are worth nothing
+    for (const auto& [muscle, priority] : user.priorities) {
+        int weight = (int)priority + 1;
+        for (MuscleMask m = muscleMaskOf(muscle); m; m &= m - 1) {
+            int id = countr_zero(m);
+            priorityWeight[id] = max(priorityWeight[id], weight);
+        }
+    }
+}
+
+int PlanOptimizer::score(const vector<PlanDay>& days) const {
+    const ExerciseTable& table = catalog.getTable();
+    int total = 0;
+    MuscleHistogram hits{};
+    //score runs once per move, its maps and lists live on the stack unless a plan is unusually big
+    array<byte, 4096> buffer;
+    pmr::monotonic_buffer_resource local(buffer.data(), buffer.size());
+    pmr::unordered_map<uint32_t, int> uses(&local);
+    pmr::vector<MuscleMask> trained(days.size(), 0, &local);
+
+    for (size_t d = 0; d < days.size(); d++) {
+        int minutes = 0;
+        const vector<PlannedExercise>& exercises = days[d].exercises;
+        for (size_t i = 0; i < exercises.size(); i++) {
+            uint32_t index = exercises[i].index;
+            MuscleMask muscles = table.muscles(index);
+            addMuscles(hits, muscles);
+            trained[d] |= muscles;
+            minutes += exercises[i].duration + 2;   //adds rest time
+            uses[index]++;
+            if (muscles & days[d].focus) total += FOCUS_BONUS;
+            for (size_t j = 0; j < i; j++) {
+                if (exercises[j].index == index) total -= DUPLICATE_COST;
+            }
+        }
+        if (minutes < minTime) total -= (minTime - minutes) * MINUTE_COST;
+        if (minutes > maxTime) total -= (minutes - maxTime) * MINUTE_COST;
+    }
+
+    //each priority muscle counts up to twice its weight in exercises, so one muscle can't take the whole week
+    for (int m = 0; m < MAX_MUSCLES; m++) {
+        total += priorityWeight[m] * min(hits[m], 2 * priorityWeight[m]);
+    }
+    for (const auto& [index, count] : uses) {
+        if (count > 2) total -= (count - 2) * REPEAT_COST;
+    }
+
+    //the plan repeats every week, so it is trained as the week before too and Monday sees Sunday
+    FatigueState fatigue;
+    for (size_t d = 0; d < days.size(); d++) {
+        fatigue.train(days[d].weekday, trained[d]);
+    }
+    fatigue.nextWeek();
+    for (size_t d = 0; d < days.size(); d++) {
+        fatigue.train(days[d].weekday, trained[d]);
+    }
+    for (size_t d = 0; d < days.size(); d++) {
+        MuscleMask overlap = trained[d] & fatigue.fatigued(days[d].weekday);
+        total -= popcount(overlap) * RECOVERY_COST;
+        if (overlap & LOWER_BODY) total -= LOWER_RECOVERY_COST;
+    }
+    return total;
+}
+
+vector<PlanDay> PlanOptimizer::optimize(vector<PlanDay> days, mt19937& rng, chrono::steady_clock::time_point deadline) const {
+    if (days.empty() || pool.exercises.empty()) return days;
+
+    int current = score(days);
+    vector<PlanDay> best = days;
+    int bestScore = current;
+
+    uniform_int_distribution<size_t> pickDay(0, days.size() - 1);
+    uniform_int_distribution<size_t> pickExercise(0, pool.exercises.size() - 1);
+    uniform_int_distribution<int> pickMove(0, 9);
+
+    while (chrono::steady_clock::now() < deadline) {
+        size_t d = pickDay(rng);
+        vector<PlannedExercise>& exercises = days[d].exercises;
+        if (exercises.empty()) continue;
+        size_t pos = uniform_int_distribution<size_t>(0, exercises.size() - 1)(rng);
+        PlannedExercise before = exercises[pos];
+
+        size_t other = d;
+        size_t otherPos = 0;
+        int kind = pickMove(rng);
+        if (kind < 3 && days.size() > 1) {
+            //swap with an exercise from another day
+            other = pickDay(rng);
+            if (other == d || days[other].exercises.empty()) continue;
+            otherPos = uniform_int_distribution<size_t>(0, days[other].exercises.size() - 1)(rng);
+            swap(exercises[pos], days[other].exercises[otherPos]);
+        } else {
+            //replace it, half the time with one for the day's focus
+            uint32_t index = pool.exercises[pickExercise(rng)];
+            if (kind < 6 && days[d].focus) {
+                const vector<uint32_t>& focused = pool.byMuscle[countr_zero(days[d].focus)];
+                if (!focused.empty()) index = focused[uniform_int_distribution<size_t>(0, focused.size() - 1)(rng)];
+            }
+            exercises[pos] = {index, timeOf(index)};
+        }
+
+        int next = score(days);
+        if (next >= current) {
+            current = next;
+            if (current > bestScore) {
+                bestScore = current;
+                best = days;
+            }
+        } else if (other != d) {
+            swap(exercises[pos], days[other].exercises[otherPos]);
+        } else {
+            exercises[pos] = before;
+        }
+    }
+    return best;
+}
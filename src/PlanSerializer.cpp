@@ -0,0 +1,305 @@
+//Writes finished plans as JSON, NDJSON, CSV or a compact binary format straight into a string buffer
+#include "PlanSerializer.h"
+#include "Muscle.h"
+#include <iostream>
+#include <charconv>
+#include <cstring>
+#include <bit>
+
+static void appendNumber(string& out, long long value) {
+    char digits[24];
+    auto result = to_chars(digits, digits + sizeof(digits), value);
+    out.append(digits, result.ptr);
+}
+
+//escapes the same way nlohmann's dump() does, other bytes including UTF-8 are copied as they are
+static void appendJsonString(string& out, string_view text) {
+    static const char hex[] = "0123456789abcdef";
+    out += '"';
+    size_t start = 0;
+    for (size_t i = 0; i < text.size(); i++) {
+        unsigned char c = text[i];
+        if (c >= 0x20 && c != '"' && c != '\\') continue;
+        out.append(text.data() + start, i - start);
+        start = i + 1;
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\b': out += "\\b"; break;
+            case '\f': out += "\\f"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                out += "\\u00";
+                out += hex[c >> 4];
+                out += hex[c & 15];
+        }
+    }
+    out.append(text.data() + start, text.size() - start);
+    out += '"';
+}
+
+//quotes a field only when it has a comma, quote or line break in it
+static void appendCsvField(string& out, string_view text) {
+    if (text.find_first_of(",\"\r\n") == string_view::npos) {
+        out += text;
+        return;
+    }
+    out += '"';
+    for (char c : text) {
+        if (c == '"') out += '"';
+        out += c;
+    }
+    out += '"';
+}
+
+//lowest byte first whatever the machine, so binary plans can be read on any of them
+template <typename T>
+static void appendLittle(string& out, T value) {
+    for (size_t b = 0; b < sizeof(T); b++) {
+        out += char((value >> (8 * b)) & 0xff);
+    }
+}
+
+bool planFormatOf(const string& name, PlanFormat& format) {
+    if (name == "json") format = PlanFormat::JSON;
+    else if (name == "ndjson") format = PlanFormat::NDJSON;
+    else if (name == "csv") format = PlanFormat::CSV;
+    else if (name == "binary") format = PlanFormat::BINARY;
+    else return false;
+    return true;
+}
+
+bool writePlan(span<const WorkoutSession> plan, PlanFormat format, string& out) {
+    switch (format) {
+        case PlanFormat::JSON: writePlanJson(plan, out); break;
+        case PlanFormat::NDJSON: writePlanNdjson(plan, out); break;
+        case PlanFormat::CSV: writePlanCsv(plan, out); break;
+        case PlanFormat::BINARY: return writePlanBinary(plan, out);
+    }
+    return true;
+}
+
+//same fields as ExerciseView::to_json, with the minutes the exercise gets in this session
+static void writeExerciseJson(ExerciseView ex, int minutes, string& out) {
+    out += "{\"exercise\":";
+    appendJsonString(out, ex.name());
+    out += ",\"muscle_groups\":[";
+    span<const uint8_t> muscles = ex.get().listedMuscles();
+    for (size_t i = 0; i < muscles.size(); i++) {
+        if (i > 0) out += ',';
+        appendJsonString(out, muscleName(muscles[i]));
+    }
+    out += "],\"equipment\":";
+    appendJsonString(out, ex.equipment());
+    out += ",\"is_compound\":";
+    out += ex.get().isCompound ? "true" : "false";
+    out += ",\"duration_minutes\":";
+    appendNumber(out, minutes);
+    out += '}';
+}
+
+void writeSessionJson(const WorkoutSession& session, string& out) {
+    out += "{\"day\":";
+    appendJsonString(out, weekdayName(session.getDay()));
+    out += ",\"session\":";
+    appendJsonString(out, session.getSessionName());
+    out += ",\"type\":";
+    appendJsonString(out, session.getTypeString());
+    out += ",\"duration_minutes\":";
+    appendNumber(out, session.getDuration());
+    out += ",\"calories\":";
+    appendNumber(out, session.getCaloriesBurned());
+
+    out += ",\"muscles\":[";
+    bool first = true;
+    for (MuscleMask mask = session.getMuscleMask(); mask; mask &= mask - 1) {
+        if (!first) out += ',';
+        first = false;
+        appendJsonString(out, muscleName(countr_zero(mask)));
+    }
+
+    out += "],\"exercises\":[";
+    span<const PlannedExercise> exercises = session.getExercises();
+    for (size_t i = 0; i < exercises.size(); i++) {
+        if (i > 0) out += ',';
+        writeExerciseJson(session.exercise(i), exercises[i].duration, out);
+    }
+    out += "]}";
+}
+
+void writePlanJson(span<const WorkoutSession> plan, string& out) {
+    int calories = 0;
+    out += "{\"sessions\":[";
+    for (size_t i = 0; i < plan.size(); i++) {
+        if (i > 0) out += ',';
+        writeSessionJson(plan[i], out);
+        calories += plan[i].getCaloriesBurned();
+    }
+    out += "],\"total_workouts\":";
+    appendNumber(out, plan.size());
+    out += ",\"total_calories\":";
+    appendNumber(out, calories);
+    out += '}';
+}
+
+void writePlanNdjson(span<const WorkoutSession> plan, string& out) {
+    for (const WorkoutSession& session : plan) {
+        writeSessionJson(session, out);
+        out += '\n';
+    }
+}
+
+//muscle groups are joined with ';' so each exercise stays one row
+void writePlanCsv(span<const WorkoutSession> plan, string& out) {
+    out += "day,session,type,exercise,equipment,muscle_groups,is_compound,duration_minutes\n";
+    for (const WorkoutSession& session : plan) {
+        span<const PlannedExercise> exercises = session.getExercises();
+        for (size_t i = 0; i < exercises.size(); i++) {
+            ExerciseView ex = session.exercise(i);
+            out += weekdayName(session.getDay());
+            out += ',';
+            appendCsvField(out, session.getSessionName());
+            out += ',';
+            appendCsvField(out, session.getTypeString());
+            out += ',';
+            appendCsvField(out, ex.name());
+            out += ',';
+            appendCsvField(out, ex.equipment());
+            out += ',';
+
+            //the muscle list is built in place and quoted afterwards if a name needs it
+            size_t musclesStart = out.size();
+            span<const uint8_t> muscles = ex.get().listedMuscles();
+            for (size_t m = 0; m < muscles.size(); m++) {
+                if (m > 0) out += ';';
+                out += muscleName(muscles[m]);
+            }
+            if (out.find_first_of(",\"\r\n", musclesStart) != string::npos) {
+                string joined = out.substr(musclesStart);
+                out.resize(musclesStart);
+                appendCsvField(out, joined);
+            }
+
+            out += ex.get().isCompound ? ",true," : ",false,";
+            appendNumber(out, exercises[i].duration);
+            out += '\n';
+        }
+    }
+}
+
+//true when every count and number of the plan fits the field the binary format has for it
+static bool fitsBinary(span<const WorkoutSession> plan) {
+    if (plan.size() > UINT32_MAX || (!plan.empty() && plan[0].getCatalog().size() > UINT32_MAX)) return false;
+    for (const WorkoutSession& session : plan) {
+        if (session.getSessionName().size() > UINT16_MAX || session.getExercises().size() > UINT16_MAX) {
+            return false;
+        }
+        for (const PlannedExercise& ex : session.getExercises()) {
+            if (ex.duration < 0 || ex.duration > UINT16_MAX) return false;
+        }
+    }
+    return true;
+}
+
+bool writePlanBinary(span<const WorkoutSession> plan, string& out) {
+    if (!fitsBinary(plan)) {
+        cerr << "Error: Plan is too big for the binary format\n";
+        return false;
+    }
+
+    //every session of a plan is from the same catalog, its size catches reading against another one
+    uint32_t catalogSize = plan.empty() ? 0 : plan[0].getCatalog().size();
+    out.append(PLAN_MAGIC, sizeof(PLAN_MAGIC));
+    appendLittle<uint32_t>(out, PLAN_VERSION);
+    appendLittle<uint32_t>(out, catalogSize);
+    appendLittle<uint32_t>(out, plan.size());
+    for (const WorkoutSession& session : plan) {
+        const string& name = session.getSessionName();
+        span<const PlannedExercise> exercises = session.getExercises();
+        appendLittle<uint8_t>(out, session.getDay());
+        appendLittle<uint8_t>(out, (uint8_t)session.getSessionType());
+        appendLittle<uint16_t>(out, name.size());
+        appendLittle<uint16_t>(out, exercises.size());
+        out.append(name);
+        for (const PlannedExercise& ex : exercises) {
+            appendLittle<uint32_t>(out, ex.index);
+            appendLittle<uint16_t>(out, ex.duration);
+        }
+    }
+    return true;
+}
+
+//reads values in the order writePlanBinary wrote them, fails once the data runs out
+class PlanReader {
+public:
+    string_view data;
+    size_t position = 0;
+
+    //little endian like appendLittle wrote it
+    template <typename T>
+    bool read(T& value) {
+        if (data.size() - position < sizeof(T)) return false;
+        value = 0;
+        for (size_t b = 0; b < sizeof(T); b++) {
+            value |= T((unsigned char)data[position + b]) << (8 * b);
+        }
+        position += sizeof(T);
+        return true;
+    }
+
+    bool readText(size_t length, string& text) {
+        if (data.size() - position < length) return false;
+        text.assign(data.data() + position, length);
+        position += length;
+        return true;
+    }
+};
+
+bool readPlanBinary(string_view data, shared_ptr<const ExerciseCatalog> catalog, double userWeight,
+                    vector<WorkoutSession>& plan) {
+    PlanReader reader{data};
+    string magic;
+    uint32_t version, catalogSize, sessionCount;
+    if (!reader.readText(sizeof(PLAN_MAGIC), magic) || memcmp(magic.data(), PLAN_MAGIC, sizeof(PLAN_MAGIC)) != 0 ||
+        !reader.read(version) || !reader.read(catalogSize) || !reader.read(sessionCount)) {
+        cerr << "Error: Not a binary plan\n";
+        return false;
+    }
+    if (version != PLAN_VERSION) {
+        cerr << "Error: Binary plan version " << version << " is not supported\n";
+        return false;
+    }
+    if (!catalog || (sessionCount > 0 && catalogSize != catalog->size())) {
+        cerr << "Error: Binary plan was made from another catalog\n";
+        return false;
+    }
+
+    vector<WorkoutSession> sessions;
+    sessions.reserve(min<size_t>(sessionCount, DAYS_IN_WEEK));
+    for (uint32_t s = 0; s < sessionCount; s++) {
+        uint8_t day, type;
+        uint16_t nameLength, exerciseCount;
+        string name;
+        if (!reader.read(day) || !reader.read(type) || !reader.read(nameLength) ||
+            !reader.read(exerciseCount) || !reader.readText(nameLength, name) ||
+            day >= DAYS_IN_WEEK || type > (uint8_t)SessionType::FULL_BODY) {
+            cerr << "Error: Binary plan is damaged\n";
+            return false;
+        }
+
+        vector<PlannedExercise> exercises(exerciseCount);
+        for (PlannedExercise& ex : exercises) {
+            uint16_t minutes;
+            if (!reader.read(ex.index) || !reader.read(minutes) || ex.index >= catalog->size()) {
+                cerr << "Error: Binary plan is damaged\n";
+                return false;
+            }
+            ex.duration = minutes;
+        }
+        sessions.emplace_back((Weekday)day, catalog, move(exercises), (SessionType)type, userWeight, move(name));
+    }
+    plan = move(sessions);
+    return true;
+}
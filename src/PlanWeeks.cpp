@@ -0,0 +1,77 @@
+//Multi week programs made one week at a time
+#include "PlanWeeks.h"
+
+PlanWeeks::PlanWeeks(const WorkoutPlanner& workoutPlanner, PlanContext context, size_t weeks)
+    : planner(workoutPlanner), ctx(move(context)), weekCount(weeks) {}
+
+PlanWeeks::PlanWeeks(const WorkoutPlanner& workoutPlanner, PlanContext context, const TrainingSchedule& dates,
+                     chrono::sys_days firstDay, size_t weeks)
+    : planner(workoutPlanner), ctx(move(context)), weekCount(weeks), schedule(dates),
+      firstMonday(firstDay - chrono::days(weekdayOf(firstDay))) {}
+
+bool PlanWeeks::next() {
+    if (made >= weekCount) {
+        made = weekCount + 1;   //past the end
+        current.clear();
+        return false;
+    }
+
+    //carries the week that is being replaced into the context
+    ctx.exerciseCount.clear();
+    ctx.fatigue.nextWeek();
+    for (const WorkoutSession& session : current) {
+        for (const PlannedExercise& ex : session.getExercises()) {
+            ctx.exerciseCount[ex.index]++;
+        }
+    }
+
+    made++;
+    if (schedule) ctx.user.workoutDays = schedule->weekOf(weekStart());
+    current = planner.makeNextWeek(ctx);
+    return true;
+}
+
+const vector<WorkoutSession>& PlanWeeks::week() const {
+    return current;
+}
+
+size_t PlanWeeks::weekNumber() const {
+    return min(made, weekCount);
+}
+
+chrono::sys_days PlanWeeks::weekStart() const {
+    size_t week = weekNumber();
+    return firstMonday + chrono::days(DAYS_IN_WEEK * (week ? week - 1 : 0));
+}
+
+bool PlanWeeks::finished() const {
+    return made > weekCount || weekCount == 0;
+}
+
+PlanWeeks::iterator PlanWeeks::begin() {
+    if (made == 0) next();
+    return iterator(this);
+}
+
+default_sentinel_t PlanWeeks::end() const {
+    return default_sentinel;
+}
+
+PlanWeeks::iterator::iterator(PlanWeeks* owner) : weeks(owner) {}
+
+const vector<WorkoutSession>& PlanWeeks::iterator::operator*() const {
+    return weeks->week();
+}
+
+PlanWeeks::iterator& PlanWeeks::iterator::operator++() {
+    weeks->next();
+    return *this;
+}
+
+void PlanWeeks::iterator::operator++(int) {
+    ++*this;
+}
+
+bool PlanWeeks::iterator::operator==(default_sentinel_t) const {
+    return !weeks || weeks->finished();
+}
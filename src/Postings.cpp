@@ -0,0 +1,123 @@
+//Sorted index list helpers used by the catalog indexes
+#include "Postings.h"
+#include <algorithm>
+#include <queue>
+#include <utility>
+#include <bit>
+
+//lists this many times longer than the other one get searched instead of merged
+static const size_t GALLOP_RATIO = 16;
+
+//first position at or after start with a value >= target, doubling the step then binary searching
+static PostingList::const_iterator gallop(PostingList::const_iterator start, PostingList::const_iterator end, uint32_t target) {
+    size_t step = 1;
+    auto low = start;
+    while (end - low > (ptrdiff_t)step && *(low + step) < target) {
+        low += step;
+        step *= 2;
+    }
+    auto high = end - low > (ptrdiff_t)step ? low + step + 1 : end;
+    return lower_bound(low, high, target);
+}
+
+PostingList intersectPostings(const PostingList& a, const PostingList& b) {
+    const PostingList& small = a.size() <= b.size() ? a : b;
+    const PostingList& large = a.size() <= b.size() ? b : a;
+
+    PostingList result;
+    if (small.empty()) return result;
+    result.reserve(small.size());
+
+    if (large.size() / small.size() >= GALLOP_RATIO) {
+        auto pos = large.begin();
+        for (uint32_t index : small) {
+            pos = gallop(pos, large.end(), index);
+            if (pos == large.end()) break;
+            if (*pos == index) result.push_back(index);
+        }
+        return result;
+    }
+
+    set_intersection(small.begin(), small.end(), large.begin(), large.end(), back_inserter(result));
+    return result;
+}
+
+PostingList unionPostings(const PostingList& a, const PostingList& b) {
+    PostingList result;
+    result.reserve(a.size() + b.size());
+    set_union(a.begin(), a.end(), b.begin(), b.end(), back_inserter(result));
+    return result;
+}
+
+//Many long lists are marked in a bitmap and read back in order, a few short ones are merged
+//with a heap of list heads. Either way duplicates drop out. Temporaries use the allocator of result.
+template <class Result>
+static void unionInto(span<const PostingList* const> lists, Result& result) {
+    using Alloc = typename Result::allocator_type;
+    using Words = vector<uint64_t, typename allocator_traits<Alloc>::template rebind_alloc<uint64_t>>;
+    using Head = pair<uint32_t, size_t>;
+    using Heads = vector<Head, typename allocator_traits<Alloc>::template rebind_alloc<Head>>;
+    using Positions = vector<size_t, typename allocator_traits<Alloc>::template rebind_alloc<size_t>>;
+    Alloc alloc = result.get_allocator();
+
+    size_t total = 0;
+    uint32_t largest = 0;
+    for (const PostingList* list : lists) {
+        total += list->size();
+        if (!list->empty()) largest = max(largest, list->back());
+    }
+    if (total == 0) return;
+
+    if (largest / 64 <= total) {
+        Words bitmap(largest / 64 + 1, 0, alloc);
+        for (const PostingList* list : lists) {
+            for (uint32_t index : *list) bitmap[index / 64] |= uint64_t(1) << (index % 64);
+        }
+        result.reserve(total);
+        for (size_t word = 0; word < bitmap.size(); word++) {
+            for (uint64_t bits = bitmap[word]; bits; bits &= bits - 1) {
+                result.push_back(uint32_t(word * 64 + countr_zero(bits)));
+            }
+        }
+        return;
+    }
+
+    priority_queue<Head, Heads, greater<Head>> heads{greater<Head>(), Heads(alloc)};
+    Positions positions(lists.size(), 0, alloc);
+    for (size_t i = 0; i < lists.size(); i++) {
+        if (!lists[i]->empty()) heads.push({(*lists[i])[0], i});
+    }
+
+    result.reserve(total);
+    while (!heads.empty()) {
+        auto [index, list] = heads.top();
+        heads.pop();
+        if (result.empty() || result.back() != index) result.push_back(index);
+        if (++positions[list] < lists[list]->size()) {
+            heads.push({(*lists[list])[positions[list]], list});
+        }
+    }
+}
+
+PostingList unionPostings(const vector<const PostingList*>& lists) {
+    if (lists.empty()) return {};
+    if (lists.size() == 1) return *lists[0];
+    if (lists.size() == 2) return unionPostings(*lists[0], *lists[1]);
+
+    PostingList result;
+    unionInto(span<const PostingList* const>(lists), result);
+    return result;
+}
+
+pmr::vector<uint32_t> unionPostings(span<const PostingList* const> lists, pmr::memory_resource* scratch) {
+    pmr::vector<uint32_t> result(scratch);
+    if (lists.size() == 1) {
+        result.assign(lists[0]->begin(), lists[0]->end());
+    } else if (lists.size() == 2) {
+        result.reserve(lists[0]->size() + lists[1]->size());
+        set_union(lists[0]->begin(), lists[0]->end(), lists[1]->begin(), lists[1]->end(), back_inserter(result));
+    } else {
+        unionInto(lists, result);
+    }
+    return result;
+}
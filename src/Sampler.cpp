@@ -0,0 +1,44 @@
+//Random picks from candidate lists without shuffling them
+#include "Sampler.h"
+
+Sampler::Sampler(span<const uint32_t> list, pmr::memory_resource* scratch) : items(list), moved(scratch) {}
+
+size_t Sampler::remaining() const {
+    return items.size() - drawn;
+}
+
+uint32_t Sampler::at(size_t pos) const {
+    for (const auto& [movedPos, item] : moved) {
+        if (movedPos == pos) return item;
+    }
+    return items[pos];
+}
+
+//swaps the item at pos with the first undrawn one and counts it as drawn
+uint32_t Sampler::take(size_t pos) {
+    uint32_t item = at(pos);
+    if (pos != drawn) {
+        uint32_t front = at(drawn);
+        bool updated = false;
+        for (auto& [movedPos, movedItem] : moved) {
+            if (movedPos == pos) {
+                movedItem = front;
+                updated = true;
+            }
+        }
+        if (!updated) moved.push_back({pos, front});
+    }
+    drawn++;
+    return item;
+}
+
+size_t Sampler::randomPos(mt19937& rng) const {
+    uniform_int_distribution<size_t> pick(drawn, items.size() - 1);
+    return pick(rng);
+}
+
+bool Sampler::next(mt19937& rng, uint32_t& item) {
+    if (remaining() == 0) return false;
+    item = take(randomPos(rng));
+    return true;
+}
@@ -0,0 +1,26 @@
+//Arena for the short lived data of a request, so threads don't fight over the global heap for it
+#include "ScratchArena.h"
+
+ScratchArena::ScratchArena(size_t initialBytes)
+    : initial(initialBytes), arena(initial.data(), initial.size(), pmr::new_delete_resource()) {}
+
+pmr::memory_resource* ScratchArena::resource() {
+    return &arena;
+}
+
+void ScratchArena::reset() {
+    arena.release();
+}
+
+ScratchArena& ScratchArena::forThread() {
+    thread_local ScratchArena arena;
+    return arena;
+}
+
+ScratchScope::ScratchScope(ScratchArena& scratchArena) : arena(scratchArena) {
+    arena.depth++;
+}
+
+ScratchScope::~ScratchScope() {
+    if (--arena.depth == 0) arena.reset();
+}
@@ -0,0 +1,64 @@
+//Fits a session into its time window exactly instead of adding and dropping exercises until it does
+#include "SessionPacker.h"
+#include <bitset>
+#include <array>
+#include <climits>
+#include <algorithm>
+
+using Minutes = bitset<MAX_SESSION_MINUTES + 1>;
+
+pmr::vector<size_t> packSession(span<const PackItem> items, int minTime, int maxTime, pmr::memory_resource* scratch) {
+    size_t count = min(items.size(), MAX_PACK_ITEMS);
+    maxTime = min(maxTime, MAX_SESSION_MINUTES);
+    minTime = max(minTime, 0);
+
+    //totals some subset can reach, to know if the window is possible before choosing
+    Minutes reachable;
+    reachable.set(0);
+    for (size_t i = 0; i < count; i++) {
+        if (items[i].minutes > 0 && items[i].minutes <= maxTime) reachable |= reachable << items[i].minutes;
+    }
+    bool windowReachable = false;
+    for (int t = minTime; t <= maxTime && !windowReachable; t++) {
+        windowReachable = reachable[t];
+    }
+
+    //best[t] is the highest value of a set taking exactly t minutes, took[i][t] marks that item i is in it
+    array<int, MAX_SESSION_MINUTES + 1> best;
+    best.fill(INT_MIN);
+    best[0] = 0;
+    array<Minutes, MAX_PACK_ITEMS> took{};
+    for (size_t i = 0; i < count; i++) {
+        int minutes = items[i].minutes;
+        if (minutes <= 0 || minutes > maxTime) continue;
+        for (int t = maxTime; t >= minutes; t--) {
+            if (best[t - minutes] == INT_MIN) continue;
+            int value = best[t - minutes] + items[i].value;
+            if (value > best[t]) {
+                best[t] = value;
+                took[i].set(t);
+            }
+        }
+    }
+
+    int end = -1;
+    if (windowReachable) {
+        for (int t = minTime; t <= maxTime; t++) {
+            if (best[t] != INT_MIN && (end < 0 || best[t] > best[end])) end = t;
+        }
+    } else {
+        for (int t = maxTime; t >= 0 && end < 0; t--) {
+            if (reachable[t]) end = t;
+        }
+    }
+
+    pmr::vector<size_t> chosen(scratch);
+    for (size_t i = count; i-- > 0 && end > 0;) {
+        if (took[i][end]) {
+            chosen.push_back(i);
+            end -= items[i].minutes;
+        }
+    }
+    reverse(chosen.begin(), chosen.end());
+    return chosen;
+}
@@ -0,0 +1,97 @@
+#include "ThreadPool.h"
+
+//index of the pool queue owned by the current thread, so tasks submitted from a worker stay local
+static thread_local const ThreadPool* currentPool = nullptr;
+static thread_local size_t currentQueue = 0;
+
+ThreadPool::ThreadPool(size_t threadCount) {
+    if (threadCount == 0) threadCount = max(1u, thread::hardware_concurrency());
+
+    for (size_t i = 0; i < threadCount; i++) {
+        queues.push_back(make_unique<Queue>());
+    }
+    for (size_t i = 0; i < threadCount; i++) {
+        workers.emplace_back([this, i] { run(i); });
+    }
+}
+
+//finishes the queued tasks before the workers exit
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<mutex> guard(sleepLock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (thread& worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::submit(function<void()> task) {
+    size_t target;
+    if (currentPool == this) {
+        target = currentQueue;
+    } else {
+        target = nextQueue.fetch_add(1, memory_order_relaxed) % queues.size();
+    }
+
+    //counted before it can be popped, otherwise a worker could take it and the count would wrap below zero
+    {
+        lock_guard<mutex> guard(sleepLock);
+        queued.fetch_add(1, memory_order_release);
+    }
+    {
+        lock_guard<mutex> guard(queues[target]->lock);
+        queues[target]->tasks.push_back(move(task));
+    }
+    wake.notify_one();
+}
+
+size_t ThreadPool::size() const {
+    return workers.size();
+}
+
+bool ThreadPool::onWorker() const {
+    return currentPool == this;
+}
+
+//own queue first (newest task), then steal the oldest task from the others
+bool ThreadPool::popTask(size_t self, function<void()>& task) {
+    {
+        Queue& own = *queues[self];
+        lock_guard<mutex> guard(own.lock);
+        if (!own.tasks.empty()) {
+            task = move(own.tasks.back());
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+    for (size_t i = 1; i < queues.size(); i++) {
+        Queue& other = *queues[(self + i) % queues.size()];
+        lock_guard<mutex> guard(other.lock);
+        if (!other.tasks.empty()) {
+            task = move(other.tasks.front());
+            other.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::run(size_t self) {
+    currentPool = this;
+    currentQueue = self;
+
+    while (true) {
+        function<void()> task;
+        if (popTask(self, task)) {
+            queued.fetch_sub(1, memory_order_acq_rel);
+            task();
+            continue;
+        }
+
+        unique_lock<mutex> guard(sleepLock);
+        wake.wait(guard, [this] { return stopping || queued.load(memory_order_acquire) > 0; });
+        if (stopping && queued.load(memory_order_acquire) == 0) return;
+    }
+}
@@ -1,11 +1,12 @@
 #include "User.h"
+#include "Fatigue.h"
 #include <algorithm>
-#include <set>
+#include <bit>
 #include <iostream>
 
 //Default constructor of user information in case user doesnt type in anythign
 User::User() : name(""), height(170), weight(70), age(25), gender("Male"),
-               workoutDays({"Monday","Wednesday", "Friday"}),
+               workoutDays(dayBit(MONDAY) | dayBit(WEDNESDAY) | dayBit(FRIDAY)),
                equipment({"Bodyweight"}),
                goal(Goal::LIGHT_BUILD) {
 
@@ -23,10 +24,10 @@ User::User() : name(""), height(170), weight(70), age(25), gender("Male"),
 }
 
 //Main constructor
-User::User(string n, int h, int w, int a, string g, vector<string> days,
+User::User(string n, int h, int w, int a, string g, DayMask days,
            unordered_set<string> equip, map<string, Priority> priority, Goal userGoal)
     : name(move(n)), height(h), weight(w), age(a), gender(move(g)),
-      workoutDays(move(days)), equipment(move(equip)),
+      workoutDays(days & ALL_DAYS), equipment(move(equip)),
       priorities(move(priority)), goal(userGoal) {}
 
 double User::getBMI() const {
@@ -71,27 +72,18 @@ vector<string> User::getLowMuscles() const {
 }
 
 bool User::hasOneDay() const {
-    return workoutDays.size() == 1;
+    return popcount((unsigned)workoutDays) == 1;
 }
 
 bool User::hasBackToDays() const {
-    if (workoutDays.size() < 2) return false;
-
-    vector<string> dayOrder = {"Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday", "Sunday"};
-    set<int> indices;
-
-    for (const string& day : workoutDays) {
-        auto it = find(dayOrder.begin(),dayOrder.end(), day);
-        if (it != dayOrder.end()) {
-            indices.insert(distance(dayOrder.begin(), it));
-        }
+    //every day trains everything, a day straight after another one still has all of it
+    //recovering while two days later only the lower body is. The week doesn't wrap here.
+    FatigueState fatigue;
+    const MuscleMask everything = FatigueState::recoveringAfter(1);
+    for (Weekday day : daysOf(workoutDays)) fatigue.train(day, everything);
+    for (Weekday day : daysOf(workoutDays)) {
+        if (fatigue.fatigued(day) == everything) return true;
     }
-
-    vector<int> ordered(indices.begin(), indices.end());
-    for (size_t i = 1; i<ordered.size(); ++i) {
-        if (ordered[i]- ordered[i - 1] == 1) return true;
-    }
-
     return false;
 }
 
@@ -113,7 +105,7 @@ void User::show() const {
     cout << "Daily Calories: "<<getDailyCalories() << "\n\n";
 
     cout << "Workout Days: ";
-    for (const string& day : workoutDays) cout << day << " ";
+    for (Weekday day : daysOf(workoutDays)) cout << weekdayName(day) << " ";
     cout << "\n\nGoal: ";
     switch (goal) {
         case Goal::ENDURANCE:cout<<"Endurance"; break;
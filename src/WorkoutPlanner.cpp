@@ -2,6 +2,11 @@
 #include "WorkoutPlanner.h"
 #include "User.h"
 #include "WorkoutSession.h"
+#include "CatalogSnapshot.h"
+#include "Sampler.h"
+#include "SessionPacker.h"
+#include "helpers.h"
+#include "PlanOptimizer.h"
 #include "json.hpp"
 #include <fstream>
 #include <iostream>
@@ -9,6 +14,10 @@
 #include <random>
 #include <unordered_map>
 #include <unordered_set>
+#include <bit>
+#include <latch>
+#include <array>
+#include <optional>
 
 using json = nlohmann::json;
 
@@ -58,96 +67,91 @@ int WorkoutPlanner::getTime(const Exercise& ex, Goal goal) const {
     return time;
 }
 
-WorkoutPlanner::WorkoutPlanner() : rng(random_device{}()) {}
-bool WorkoutPlanner::loadData(const string& filename) {
-    ifstream file(filename);
-    if (!file.is_open()) {
-        cerr << "File failed to open"<<filename<<endl;
-        return false;
-    }
-
-    json j;
-    file >> j;
+WorkoutPlanner::WorkoutPlanner() {}
 
-    exercises.clear();
-    for (const auto& item : j) {
-        exercises.push_back(Exercise::from_json(item));
-    }
+WorkoutPlanner::WorkoutPlanner(shared_ptr<const ExerciseCatalog> exerciseCatalog)
+    : catalog(move(exerciseCatalog)) {}
 
-    cout <<"Loaded" << exercises.size() << "exercises from file.\n";
+//Loads either the JSON database or a compiled snapshot of it
+bool WorkoutPlanner::loadData(const string& filename) {
+    auto loaded=isSnapshot(filename) ? loadSnapshot(filename) : ExerciseCatalog::load(filename);
+    if (!loaded) return false;
+    catalog=move(loaded);
     return true;
 }
 
-void WorkoutPlanner::setUser(const User& u) {
-    user = u;
-    lastTrained.clear();
-    exerciseCount.clear();
+//Swapping the catalog is not thread safe, plans already made keep working
+void WorkoutPlanner::setCatalog(shared_ptr<const ExerciseCatalog> exerciseCatalog) {
+    catalog=move(exerciseCatalog);
 }
 
-//Lets the user expand equipment option so they could select which equipments they have avaliable.
-unordered_set<string> WorkoutPlanner::expandEquipment(const unordered_set<string>& equipment)const {
-    unordered_set<string> expanded;
+shared_ptr<const ExerciseCatalog> WorkoutPlanner::getCatalog() const {
+    return catalog;
+}
 
-    for (const string& item:equipment) {
-        expanded.insert(item);
+void WorkoutPlanner::setUser(const User& u) {
+    context.user = u;
+    context.reset();
+}
+
+//makes the next plans reproducible, otherwise the rng starts from random_device
+void WorkoutPlanner::setSeed(uint64_t seed) {
+    context.rng.seed(seed);
+}
 
-        if (equipmentMap.find(item)!=equipmentMap.end()){
-            for (const string& specific : equipmentMap.at(item)) {
-                expanded.insert(specific);
-            }}
+//Reduces the users equipment to one mask of item ids. Categories let the user select all equipment
+//of one kind, those count as every specific item in them.
+EquipmentMask WorkoutPlanner::ownedEquipment(const User& user) const {
+    const EquipmentVocab& vocab=catalog->getEquipmentVocab();
+    EquipmentMask owned=EquipmentVocab::bit(EquipmentVocab::BODYWEIGHT);
+    for (const string& item : user.equipment) {
+        owned|=vocab.itemMask(item);
+        auto category=equipmentMap.find(item);
+        if (category!=equipmentMap.end()) {
+            for (const string& specific : category->second) {
+                owned|=vocab.itemMask(specific);
+            }
+        }
     }
-    return expanded;
+    return owned;
 }
 
 //determines if the workouts requires machines, dumbells, just bodyweight, etc..
-vector<Exercise> WorkoutPlanner::filterEquipment(const vector<Exercise>&list)const {
-    vector<Exercise> filtered;
-    unordered_set<string> expanded = expandEquipment(user.equipment);
+vector<uint32_t> WorkoutPlanner::filterEquipment(const PlanContext& ctx) const {
+    return catalog->equipmentExercises(ownedEquipment(ctx.user));
+}
 
-    for (const Exercise& ex : list) {
-        bool hasEquip = false;
+vector<uint32_t> WorkoutPlanner::filterEquipment(const vector<uint32_t>& list, const PlanContext& ctx) const {
+    EquipmentMask owned = ownedEquipment(ctx.user);
+    if (is_sorted(list.begin(), list.end())) {
+        return intersectPostings(list, catalog->equipmentExercises(owned));
+    }
 
-        if (ex.equipment == "Bodyweight") {
-            hasEquip = true;
-        } else {
-            for (const string& available:expanded) {
-                if (ex.equipment.find(available) !=string::npos ||
-                    available.find(ex.equipment) !=string::npos) {
-                    hasEquip =true;
-                    break;}
-            }
-        }
-        if (hasEquip) {
-            filtered.push_back(ex);
+    const ExerciseTable& table = catalog->getTable();
+    vector<uint32_t> filtered;
+
+    for (uint32_t index : list) {
+        if (table.canDo(index, owned)) {
+            filtered.push_back(index);
         }
     }
     return filtered;
 }
 //Arms has sub categories of biceps and triceps which is stated specifically in the JSON file.
-//Legs has sub categories of quads and hamstrings, while other muscle groups sticks to their name
-vector<string> WorkoutPlanner::expandMuscles(const vector<string>& muscles) const {
-    vector<string> expanded;
-
-    for (const string& muscle : muscles) {
-        if (muscle == "Arms") {
-            expanded.push_back("Biceps");
-            expanded.push_back("Triceps");
-        } else if (muscle == "Legs") {
-            expanded.push_back("Quads");
-            expanded.push_back("Hamstrings");
-        } else {
-            expanded.push_back(muscle);
-        }
-    }
-    return expanded;
-}
-
-vector<Exercise> WorkoutPlanner::filterMuscles(const vector<Exercise>& list, const vector<string>& targets) const {
-    vector<Exercise> filtered;
-    vector<string> expanded = expandMuscles(targets);
-    for (const Exercise& ex : list) {
-        if (ex.targetsAnyMuscle(expanded)) {
-            filtered.push_back(ex);
+//Legs has sub categories of quads and hamstrings, while other muscle groups sticks to their name.
+//muscleMaskOf expands those so the check per exercise is one mask compare
+vector<uint32_t> WorkoutPlanner::filterMuscles(const vector<uint32_t>& list, const vector<string>& targets) const {
+    MuscleMask targetMask = muscleMaskOf(targets);
+    //a sorted list can be intersected with the muscle index instead of checked one by one
+    if (is_sorted(list.begin(), list.end())) {
+        return intersectPostings(list, catalog->muscleExercises(targetMask));
+    }
+
+    const ExerciseTable& table = catalog->getTable();
+    vector<uint32_t> filtered;
+    for (uint32_t index : list) {
+        if (table.muscles(index) & targetMask) {
+            filtered.push_back(index);
         }
     }
     return filtered;
@@ -155,329 +159,312 @@ vector<Exercise> WorkoutPlanner::filterMuscles(const vector<Exercise>& list, con
 
 //some workouts like pushups target multiple muscle groups like chest, core and triceps. So commpound
 //added just a user selects high priority for all muscle groups and only avalaible for 1 workout session in the week.
-vector<Exercise> WorkoutPlanner::getCompounds() const {
-    vector<Exercise> compounds;
+vector<uint32_t> WorkoutPlanner::getCompounds() const {
+    return catalog->compoundExercises();
+}
 
-    for (const Exercise& ex : exercises) {
-        if (ex.isCompound) {
-            compounds.push_back(ex);
-        }
+vector<uint32_t> WorkoutPlanner::filterExercises(const PlanContext& ctx, MuscleMask targets, bool compoundOnly) const {
+    ScratchScope scope(ctx.scratchArena());
+    ScratchList repeated(ctx.scratch());
+    for (const auto& [index, count] : ctx.exerciseCount) {
+        if (count >= 2) repeated.push_back(index);
     }
-    return compounds;
+    sort(repeated.begin(), repeated.end());
+
+    TableFilter filter;
+    filter.owned = ownedEquipment(ctx.user);
+    filter.muscles = targets;
+    filter.compoundOnly = compoundOnly;
+    filter.exclude = repeated;
+    return catalog->getTable().scan(filter);
 }
 
-//Training legs for ex two times in a row is not ideal for muscle growth. Muscles need rest so this fuction will check the last muscle group trained to avoid having to train the group twice in a row.
-vector<Exercise> WorkoutPlanner::avoidRecent(const vector<Exercise>& list, const string& day) const {
+//Looks up which exercises the user can do once per plan, every later step picks from the pool
+//instead of scanning the whole catalog again. Users with the same equipment share one pool.
+void WorkoutPlanner::preparePool(PlanContext& ctx) const {
+    ctx.pool=&catalog->eligiblePool(ownedEquipment(ctx.user), ctx.poolStorage);
+    ctx.underRepeatLimit.clear();
+    ctx.repeatPoolReady=false;
+    ctx.favored=muscleMaskOf(ctx.user.getHighMuscles());
+}
 
-    vector<string> prevDays = getPrevDay(day);
-    unordered_set<string> recent;
-    for (const string& prevDay : prevDays) {
-        if (lastTrained.find(prevDay)!=lastTrained.end()) {
-            for (const string& muscle: lastTrained.at(prevDay)) {
-                recent.insert(muscle);
-            }
-        }
+//counts a picked exercise and drops it from the repeat pool once it has been used twice
+void WorkoutPlanner::countPick(uint32_t index, PlanContext& ctx) const {
+    if (++ctx.exerciseCount[index]==2 && ctx.repeatPoolReady) {
+        auto it=lower_bound(ctx.underRepeatLimit.begin(), ctx.underRepeatLimit.end(), index);
+        if (it!=ctx.underRepeatLimit.end() && *it==index) ctx.underRepeatLimit.erase(it);
+    }
+}
+
+//same as limitRepeats on the whole pool, but only filtered the first time it is needed
+const vector<uint32_t>& WorkoutPlanner::repeatPool(PlanContext& ctx) const {
+    if (!ctx.repeatPoolReady) {
+        ScratchList filtered=limitRepeats(ctx.pool->exercises, ctx);
+        ctx.underRepeatLimit.assign(filtered.begin(), filtered.end());
+        ctx.repeatPoolReady=true;
+    }
+    return ctx.underRepeatLimit;
+}
+
+//exercises in the pool for the target muscles, a union of the per muscle lists
+ScratchList WorkoutPlanner::musclePool(const EligiblePool& pool, MuscleMask targets, const PlanContext& ctx) const {
+    array<const PostingList*, MAX_MUSCLES> lists;
+    size_t count=0;
+    for (MuscleMask m = targets; m; m &= m - 1) {
+        lists[count++] = &pool.byMuscle[countr_zero(m)];
     }
+    return unionPostings(span<const PostingList* const>(lists.data(), count), ctx.scratch());
+}
+
+//Weight for filling a day, high priority muscles and compound movements come up more often
+static const double MAX_PICK_WEIGHT=2.5;
 
-    vector<Exercise> filtered;
-    for (const Exercise& ex : list) {
-        bool conflicts = false;
-        for (const string& muscle : ex.muscleGroups) {
-            if (recent.count(muscle)) {
-                conflicts = true;
-                break;
+double WorkoutPlanner::pickWeight(uint32_t index, const PlanContext& ctx) const {
+    const ExerciseTable& table=catalog->getTable();
+    double weight=1.0;
+    if (table.muscles(index) & ctx.favored) weight+=1.0;
+    if (table.isCompound(index)) weight+=0.5;
+    return weight;
+}
+
+//Training legs for ex two times in a row is not ideal for muscle growth. Muscles need rest so this fuction will check which muscles are still recovering to avoid having to train the group twice in a row.
+ScratchList WorkoutPlanner::avoidRecent(span<const uint32_t> list, Weekday day, const PlanContext& ctx) const {
+    ScratchList filtered(ctx.scratch());
+    MuscleMask recent = ctx.fatigue.fatigued(day);
+    if (recent) {
+        const ExerciseTable& table = catalog->getTable();
+        for (uint32_t index : list) {
+            if (!(table.muscles(index) & recent)) {
+                filtered.push_back(index);
             }
         }
-        if (!conflicts) {
-            filtered.push_back(ex);
-        }
     }
-    return filtered.empty() ? list : filtered;
+    if (filtered.empty()) filtered.assign(list.begin(), list.end());
+    return filtered;
 }
 
-vector<Exercise> WorkoutPlanner::limitRepeats(const vector<Exercise>& list) const {
-    vector<Exercise> filtered;
+ScratchList WorkoutPlanner::limitRepeats(span<const uint32_t> list, const PlanContext& ctx) const {
+    ScratchList filtered(ctx.scratch());
 
-    for (const Exercise& ex : list) {
+    for (uint32_t index : list) {
         int count = 0;
-        if (exerciseCount.find(ex.name) != exerciseCount.end()) {
-            count = exerciseCount.at(ex.name);
+        auto it = ctx.exerciseCount.find(index);
+        if (it != ctx.exerciseCount.end()) {
+            count = it->second;
         }
 
         if (count < 2) {
-            filtered.push_back(ex);
+            filtered.push_back(index);
         }
     }
-    return filtered.empty() ? list : filtered;
+    if (filtered.empty()) filtered.assign(list.begin(), list.end());
+    return filtered;
 }
 
 //func. will list out session type based on which muscle group is being traned the most.
-SessionType WorkoutPlanner::getType(const vector<Exercise>& list) const {
+SessionType WorkoutPlanner::getType(const vector<PlannedExercise>& list) const {
     int cardio = 0;
     int strength = 0;
-    unordered_map<string, int> muscleCount;
-
-    for (const Exercise& ex : list) {
-        bool isCardio= false;
-        for (const string& muscle :ex.muscleGroups) {
-            if (muscle =="Cardio") {
-                cardio++;
-                isCardio=true;
-            } else {
-                muscleCount[muscle]++;
-            }
-        } if (!isCardio) strength++;
+    MuscleMask trained = 0;
+    const MuscleMask cardioBit = muscleBit(MUSCLE_CARDIO);
+
+    for (const PlannedExercise& planned : list) {
+        const Exercise& ex = catalog->get(planned.index);
+        if (ex.muscleMask & cardioBit) {
+            cardio++;
+        } else {
+            strength++;
+        }
+        trained |= ex.muscleMask & ~cardioBit;
     }
 
     if (cardio>0 && strength>0) return SessionType::MIXED;
     if (cardio >strength) return SessionType::CARDIO;
 
     // Checks for full body vs strength training
-    bool hasUpper=false;
-    bool hasLower=false;
-
-    //upper body muscle groups
-    for (const auto& [muscle,count]:muscleCount) {
-        if (muscle == "Chest" || muscle == "Back"|| muscle == "Shoulders" ||
-            muscle == "Arms"||muscle=="Biceps" || muscle=="Triceps") {
-            hasUpper = true;
-        }
+    bool hasUpper=(trained & UPPER_BODY)!=0;
+    bool hasLower=(trained & LOWER_BODY)!=0;
 
-        //lower body muscle groups
-        if (muscle=="Legs" || muscle == "Quads" ||muscle == "Hamstrings" ||
-            muscle=="Glutes" ||muscle=="Calves") {
-            hasLower = true;
-        }
-    }
     //if the workout has both upper and lower body workouts then it would be considered full body
-    if (hasUpper && hasLower && muscleCount.size() >= 4) {
+    if (hasUpper && hasLower && popcount(trained) >= 4) {
         return SessionType::FULL_BODY;
     }
     return SessionType::STRENGTH;
 }
 
-string WorkoutPlanner::getName(const vector<Exercise>& list)const{
-    unordered_map<string, int>muscleCount;
+string WorkoutPlanner::getName(const vector<PlannedExercise>& list)const{
+    MuscleHistogram muscleCount{};
+    MuscleMask trained=0;
     bool hasCardio=false;
+    const MuscleMask cardioBit=muscleBit(MUSCLE_CARDIO);
 
-    for (const Exercise& ex:list) {
-        for (const string& muscle : ex.muscleGroups) {
-            if (muscle == "Cardio") {
-                hasCardio = true;
-            }
-            else {
-                muscleCount[muscle]++;
-            }}
+    for (const PlannedExercise& planned:list) {
+        const Exercise& ex=catalog->get(planned.index);
+        if (ex.muscleMask & cardioBit) {
+            hasCardio = true;
+        }
+        addMuscles(muscleCount, ex.muscleMask & ~cardioBit);
+        trained|=ex.muscleMask & ~cardioBit;
     }
 
-    if (hasCardio && muscleCount.size()>2) {
+    if (hasCardio && popcount(trained)>2) {
         return "Full Body + Cardio";
     }
     if (hasCardio) return "Cardio Day";
 
     //will map back to UI muscle groups
-    unordered_map<string, int> uiCount;
-    for (const auto& [muscle, count]:muscleCount) {
-        if (muscle == "Biceps"||muscle=="Triceps") {
-            uiCount["Arms"] += count;
-        } else if (muscle =="Quads" || muscle =="Hamstrings") {
-            uiCount["Legs"]+=count;
-        }
-        else {
-            uiCount[muscle]+=count;
-        }
-    }
+    MuscleHistogram uiCount=muscleCount;
+    uiCount[MUSCLE_ARMS]+=uiCount[MUSCLE_BICEPS]+uiCount[MUSCLE_TRICEPS];
+    uiCount[MUSCLE_LEGS]+=uiCount[MUSCLE_QUADS]+uiCount[MUSCLE_HAMSTRINGS];
+    uiCount[MUSCLE_BICEPS]=uiCount[MUSCLE_TRICEPS]=0;
+    uiCount[MUSCLE_QUADS]=uiCount[MUSCLE_HAMSTRINGS]=0;
 
     // Finds dominant muscle group
     //A session might train more than one muscle group like arms and back but this function will determine main group like "BACK"
-    string primary = "";
+    int primary = -1;
     int maxCount = 0;
-    for (const auto&[muscle,count]:uiCount) {
-        if (count>maxCount) {
-            maxCount=count;
-            primary=muscle;
+    for (int id=0; id<MAX_MUSCLES; id++) {
+        if (uiCount[id]>maxCount) {
+            maxCount=uiCount[id];
+            primary=id;
         }}
-    if (primary == "Chest")
-        return "Chest Day";
-
-    if (primary == "Back")
-        return "Back Day";
-
-    if (primary == "Shoulders")
-        return "Shoulder Day";
-
-    if (primary == "Arms")
-        return "Arm Day";
-
-    if (primary == "Legs")
-        return "Leg Day";
-
-    if (primary == "Glutes")
-        return "Glute Day";
-
-    if (primary == "Core")
-        return "Core Day";
-
-    return "Strength Training";
+    switch (primary) {
+        case MUSCLE_CHEST: return "Chest Day";
+        case MUSCLE_BACK: return "Back Day";
+        case MUSCLE_SHOULDERS: return "Shoulder Day";
+        case MUSCLE_ARMS: return "Arm Day";
+        case MUSCLE_LEGS: return "Leg Day";
+        case MUSCLE_GLUTES: return "Glute Day";
+        case MUSCLE_CORE: return "Core Day";
+        default: return "Strength Training";
+    }
 }
 
 
 //Makes sure we have enough exercises for the workout
-vector<Exercise> WorkoutPlanner::ensureMin(vector<Exercise> list, int min) const {
+ScratchList WorkoutPlanner::ensureMin(ScratchList list, size_t min, PlanContext& ctx) const {
     if(list.size()>=min) return list;  //already have enough
 
     //Gets all exercises we can use
-    vector<Exercise> available=filterEquipment(exercises);
-    available=limitRepeats(available);
-    //Tracks what we already picked
-    unordered_set<string> selected;
-    for(const Exercise& ex : list) {
-        selected.insert(ex.name);
-    }
-
-    vector<Exercise> additional;
-    for (const Exercise& ex : available) {
-        if (selected.find(ex.name)==selected.end()) {
-            additional.push_back(ex);
+    const vector<uint32_t>& available=repeatPool(ctx);
+
+    //Draws random ones and skips what we already picked, the list is only a handful of exercises
+    Sampler picks(available, ctx.scratch());
+    auto weight=[this, &ctx](uint32_t index) { return pickWeight(index, ctx); };
+    uint32_t index;
+    while (list.size()<min && picks.next(ctx.rng, index, weight, MAX_PICK_WEIGHT)) {
+        if (find(list.begin(), list.end(), index)==list.end()) {
+            list.push_back(index);
         }
     }
-    //Randomizes the order
-    shuffle(additional.begin(), additional.end(),rng);
-
-    int needed=min-list.size();
-    for(int i=0; i<needed && i<additional.size(); i++) {
-        list.push_back(additional[i]);
-    }
 
     return list;
 }
-//Keep workout within time limits which cap limit of 1hr 30min
-vector<Exercise> WorkoutPlanner::limitTime(const vector<Exercise>& list, int minTime, int maxTime) const {
-    vector<Exercise> result=list;
-
-    int total=0;
-    for(const Exercise& ex : result) {
-        total += ex.estimatedDurationMinutes+2;  //adds rest time
-    }
+//Keep workout within time limits which cap limit of 1hr 30min.
+//The packer picks the set that fits the window, the exercises already picked are worth the most
+//(earliest first, those are the primary muscle ones) and random extras from the repeat pool cost
+//more than they give so they only get in when the session is too short without them.
+static const int KEEP_VALUE=1000;
+static const int FILL_COST=100;
 
-    if(total<minTime) {
-        // Need to add more exercises
-        vector<Exercise> available=filterEquipment(exercises);
-        available=limitRepeats(available);
+vector<PlannedExercise> WorkoutPlanner::limitTime(vector<PlannedExercise> result, int minTime, int maxTime, PlanContext& ctx) const {
+    if(checkDuration(result, minTime, maxTime)) return result;
 
-        unordered_set<string> selected;
-        for (const Exercise& ex:result) {
-            selected.insert(ex.name);
-        }
-        vector<Exercise> additional;
-        for (const Exercise& ex:available) {
-            if(selected.find(ex.name)==selected.end()) {
-                additional.push_back(ex);
-            }
-        }
-        shuffle(additional.begin(),additional.end(), rng);
+    pmr::vector<PackItem> items(ctx.scratch());
+    for(size_t i=0; i<result.size() && items.size()<MAX_PACK_ITEMS; i++) {
+        items.push_back({result[i].index, result[i].duration+2, KEEP_VALUE-(int)i});  //adds rest time
+    }
 
-        for(const Exercise& ex:additional) {
-            if (total>=minTime) break;
-            result.push_back(ex);
-            total+=ex.estimatedDurationMinutes+2;
-        }
+    const vector<uint32_t>& available=repeatPool(ctx);
+    Sampler picks(available, ctx.scratch());
+    uint32_t index;
+    while (items.size()<MAX_PACK_ITEMS && picks.next(ctx.rng, index)) {
+        bool selected=any_of(result.begin(), result.end(),
+                             [index](const PlannedExercise& ex) { return ex.index==index; });
+        if(selected) continue;
+        int duration=catalog->get(index).estimatedDurationMinutes;
+        items.push_back({index, duration+2, (int)(pickWeight(index, ctx)*10)-FILL_COST});
     }
 
-    //Remove exercises if too long
-    while(total>maxTime && result.size()>5) {
-        total-=(result.back().estimatedDurationMinutes+2);
-        result.pop_back();
+    vector<PlannedExercise> packed;
+    for(size_t pos : packSession(items, minTime, maxTime, ctx.scratch())) {
+        packed.push_back({items[pos].index, items[pos].minutes-2});
+    }
+    if(!checkDuration(packed, minTime, maxTime)) {
+        cout << "Warning: Not enough exercises to fill a " << minTime << "-" << maxTime << " minute session.\n";
     }
-    return result;
+    return packed;
 }
 
-bool WorkoutPlanner::hasCardioBack(const vector<WorkoutSession>& plan, const string& day) const {
-    vector<string> prevDays=getPrevDay(day);
-
-    for(const string& prevDay : prevDays) {
-        for (const WorkoutSession& session : plan) {
-            if(session.getDay()==prevDay &&
-                (session.getSessionType()==SessionType::CARDIO ||
-                 session.getSessionType()==SessionType::MIXED)) {
-                return true;
-                 }
-        }}
-    return false;
+//Cardio the day before, cardio and mixed sessions both train the cardio muscle group
+bool WorkoutPlanner::hasCardioBack(const PlanContext& ctx, Weekday day) const {
+    return ctx.fatigue.fatigued(day) & muscleBit(MUSCLE_CARDIO);
 }
 
-//Checks if previous day was a lower body workout as muscles need atleast 48-72hrs of rest before traning it agaib
-bool WorkoutPlanner::hasLowerBack(const vector<WorkoutSession>& plan, const string& day) const {
-    vector<string> prevDays=getPrevDay(day);
-
-    //checks if yesterday was leg day, glute, hanstring etc.. and if yes, avoids lower body for today
-    //if yesterday wasn't leg day then leg day is okay to put on that day of the week
-    vector<string> lowerSessions={
-        "Glutes & Hamstrings", "Quads & Glutes", "Quads & Calves",
-        "Glute Focus", "Quad Focus", "Hamstring Focus", "Leg Day"
-    };
-    for (const string& prevDay : prevDays) {
-        for(const WorkoutSession& session : plan) {
-            if(session.getDay()==prevDay) {
-                string sessionName=session.getSessionName();
-                for(const string& lowerName : lowerSessions) {
-                    if (sessionName.find(lowerName)!=string::npos) {
-                        return true;
-                    }
-                }
-            }
-        }
-    }
-    return false;
+//Checks if the lower body is still recovering as muscles need atleast 48-72hrs of rest before traning it agaib
+bool WorkoutPlanner::hasLowerBack(const PlanContext& ctx, Weekday day) const {
+    return ctx.fatigue.fatigued(day) & LOWER_BODY;
 }
 
-vector<string> WorkoutPlanner::getPrevDay(const string& day) const {
-    vector<string> days={"Monday","Tuesday", "Wednesday", "Thursday", "Friday", "Saturday","Sunday"};
-    vector<string> prev;
-    auto it=find(days.begin(), days.end(), day);
-    if(it!=days.end() && it!=days.begin()) {
-        prev.push_back(*(it-1));
-    }
-
-    return prev;
+vector<WorkoutSession> WorkoutPlanner::makePlan() {
+    return makePlan(context);
 }
 
-int WorkoutPlanner::getDayNum(const string& day) const {
-    vector<string> days={"Monday", "Tuesday", "Wednesday","Thursday", "Friday", "Saturday", "Sunday"};
-    auto it=find(days.begin(), days.end(),day);
-    return it!=days.end() ? distance(days.begin(),it) :-1;
+// Main algorithm to create weekly workout plan
+//Only reads the catalog and changes ctx, so it can run on many threads with one context each
+vector<WorkoutSession> WorkoutPlanner::makePlan(PlanContext& ctx) const {
+    ctx.exerciseCount.clear();
+    ctx.fatigue.clear();
+    return makeNextWeek(ctx);
 }
 
-// Main algorithm to create weekly workout plan
-vector<WorkoutSession> WorkoutPlanner::makePlan() {
+vector<WorkoutSession> WorkoutPlanner::makeNextWeek(PlanContext& ctx) const {
+    ScratchScope scope(ctx.scratchArena());
     vector<WorkoutSession> plan;
-    exerciseCount.clear();
+    const User& user=ctx.user;
 
-    if(exercises.empty()) {
+    if(!catalog || catalog->empty()) {
         cout << "Error: No exercises loaded.\n";
         return plan;
     }
+    preparePool(ctx);
+
     // Handle single day case
     if(user.hasOneDay()) {
-        vector<Exercise> fullBody=makeDay();
+        vector<PlannedExercise> fullBody=buildDay(ctx);
         if(!fullBody.empty()) {
             string sessionName=getName(fullBody);
             //makes the workout a full Session and adds in compound workouts like squats
-            WorkoutSession session(user.workoutDays[0], fullBody,SessionType::FULL_BODY);
-            session.setSessionName(sessionName);
-            plan.push_back(session);
+            plan.emplace_back(daysOf(user.workoutDays)[0], catalog, move(fullBody), SessionType::FULL_BODY,
+                              user.weight, move(sessionName));
         }
         return plan;
     }
 
 
     //edge case to address if there are little exercises avaliable based on the equipment the user selected
-    vector<Exercise> available=filterEquipment(exercises);
+    const vector<uint32_t>& available=ctx.pool->exercises;
 
     if (available.size()<5) {
         cout << "Warning: Few exercises available with current equipment.\n";
     }
-    //Get muscle priorities
+    vector<string> allMuscles=priorityMuscles(user);
+
+    int dayIdx=0;
+    for(DayMask days=user.workoutDays; days; days&=days-1, dayIdx++) {
+        Weekday day=(Weekday)countr_zero((unsigned)days);
+        string primaryMuscle=dayFocus(dayIdx, allMuscles, user);
+
+        vector<PlannedExercise> planned=buildSession(day, primaryMuscle, allMuscles, ctx);
+        if(!planned.empty()) {
+            plan.push_back(finishSession(day, primaryMuscle, move(planned), ctx));
+        }
+    }
+    return plan;
+}
+
+//Get muscle priorities, high first
+vector<string> WorkoutPlanner::priorityMuscles(const User& user) const {
     vector<string> high=user.getHighMuscles();
     vector<string> medium=user.getMediumMuscles();
     vector<string> low=user.getLowMuscles();
@@ -485,113 +472,316 @@ vector<WorkoutSession> WorkoutPlanner::makePlan() {
     allMuscles.insert(allMuscles.end(),high.begin(),high.end());
     allMuscles.insert(allMuscles.end(),medium.begin(),medium.end());
     allMuscles.insert(allMuscles.end(),low.begin(), low.end());
+    return allMuscles;
+}
 
-    for(int dayIdx=0;dayIdx<user.workoutDays.size(); dayIdx++) {
-        string day=user.workoutDays[dayIdx];
-        vector<Exercise> dayExercises;
+//Each day trains the next muscle by priority, once every muscle has a day the high ones come around again
+string WorkoutPlanner::dayFocus(int dayIdx, const vector<string>& allMuscles, const User& user) const {
+    if (dayIdx<allMuscles.size()) {
+        return allMuscles[dayIdx];
+    }
+    vector<string> high=user.getHighMuscles();
+    if (high.empty()) {
+        return allMuscles.empty() ? "" : allMuscles[dayIdx%allMuscles.size()];
+    }
+    return high[dayIdx%high.size()];
+}
 
-        string primaryMuscle="";
-        if (dayIdx<allMuscles.size()) {
-            primaryMuscle=allMuscles[dayIdx];
-        } else {
-            primaryMuscle=high[dayIdx%high.size()];
-        }
+//Picks one day's exercises, the primary muscle first then the other priorities
+vector<PlannedExercise> WorkoutPlanner::buildSession(Weekday day, const string& primaryMuscle,
+                                                     const vector<string>& allMuscles, PlanContext& ctx) const {
+    ScratchList dayExercises(ctx.scratch());
+
+    //Get exercises for main muscle group
+    ScratchList primaryExs=musclePool(*ctx.pool, muscleMaskOf(primaryMuscle), ctx);
+    primaryExs=avoidRecent(primaryExs, day, ctx);
+    primaryExs=limitRepeats(primaryExs, ctx);
 
-        //Get exercises for main muscle group
-        vector<Exercise> primaryExs=filterMuscles(available, {primaryMuscle});
-        primaryExs=avoidRecent(primaryExs, day);
-        primaryExs=limitRepeats(primaryExs);
+    Sampler primaryPicks(primaryExs, ctx.scratch());
+    uint32_t index;
+    while (dayExercises.size()<4 && primaryPicks.next(ctx.rng, index)) {
+        dayExercises.push_back(index);
+    }
 
-        if(!primaryExs.empty()) {
-            shuffle(primaryExs.begin(),primaryExs.end(), rng);
-            int primaryCount=min(4, (int)primaryExs.size());
-            for(int i=0; i<primaryCount; i++) {
-                dayExercises.push_back(primaryExs[i]);
+    //Fills in remaining spots with other exercises for a more balanced workout based on user muscle priotites
+    if(dayExercises.size()<5) {
+        MuscleMask secondary=0;
+        for (const string& muscle : allMuscles) {
+            if(muscle!=primaryMuscle) {
+                secondary|=muscleMaskOf(muscle);
             }
         }
+        ScratchList secondaryExs=musclePool(*ctx.pool, secondary, ctx);
+        secondaryExs=limitRepeats(secondaryExs, ctx);
+        Sampler secondaryPicks(secondaryExs, ctx.scratch());
+        auto weight=[this, &ctx](uint32_t index) { return pickWeight(index, ctx); };
+        while (dayExercises.size()<5 && secondaryPicks.next(ctx.rng, index, weight, MAX_PICK_WEIGHT)) {
+            dayExercises.push_back(index);
+        }
+    }
 
-        //Fills in remaining spots with other exercises for a more balanced workout based on user muscle priotites
-        if(dayExercises.size()<5) {
-            vector<string> secondary;
-            for (const string& muscle : allMuscles) {
-                if(muscle!=primaryMuscle) {
-                    secondary.push_back(muscle);
-                }
+    dayExercises=ensureMin(move(dayExercises), 5, ctx);
+
+    //Sets exercise times based on training goal.
+    //If the users training goal is Endurance, its sets and time between setss would be very different from Strength (no recommened for beginners)
+    vector<PlannedExercise> planned;
+    planned.reserve(dayExercises.size());
+    for(uint32_t index : dayExercises) {
+        planned.push_back({index, getTime(catalog->get(index), ctx.user.goal)});
+    }
+    return limitTime(move(planned), 45, 90, ctx);
+}
+
+//counts the picks and remembers what the day trained for the days after it
+WorkoutSession WorkoutPlanner::finishSession(Weekday day, const string& primaryMuscle,
+                                             vector<PlannedExercise> planned, PlanContext& ctx) const {
+    SessionType sessionType=SessionType::STRENGTH;
+
+    for(const PlannedExercise& ex : planned) {
+        countPick(ex.index, ctx);
+    }
+    WorkoutSession session(day, catalog, move(planned), sessionType, ctx.user.weight, primaryMuscle+" Day");
+    ctx.fatigue.train(day, session.getMuscleMask());
+    return session;
+}
+
+//makePlan names days after their primary muscle, the focus comes back from the name
+string WorkoutPlanner::sessionFocus(const WorkoutSession& session) const {
+    const string& name=session.getSessionName();
+    if(name.size()>4 && name.compare(name.size()-4, 4, " Day")==0) {
+        return name.substr(0, name.size()-4);
+    }
+    return "";
+}
+
+vector<WorkoutSession> WorkoutPlanner::makePlan(PlanContext& ctx, chrono::microseconds budget) const {
+    ScratchScope scope(ctx.scratchArena());
+    auto deadline=chrono::steady_clock::now()+budget;
+    vector<WorkoutSession> plan=makePlan(ctx);
+    if(plan.empty() || chrono::steady_clock::now()>=deadline) return plan;
+
+    vector<PlanDay> days;
+    for(const WorkoutSession& session : plan) {
+        string focus=sessionFocus(session);
+        span<const PlannedExercise> exercises=session.getExercises();
+        days.push_back({session.getDay(), focus.empty() ? 0 : muscleMaskOf(focus), {exercises.begin(), exercises.end()}});
+    }
+
+    PlanOptimizer optimizer(*catalog, *ctx.pool, ctx.user,
+                            [this, &ctx](uint32_t index) { return getTime(catalog->get(index), ctx.user.goal); });
+    days=optimizer.optimize(move(days), ctx.rng, deadline);
+
+    //rebuilds the sessions and the context so it matches the plan that is returned
+    ctx.exerciseCount.clear();
+    ctx.fatigue.clear();
+    vector<WorkoutSession> improved;
+    improved.reserve(plan.size());
+    for(size_t i=0; i<plan.size(); i++) {
+        for(const PlannedExercise& ex : days[i].exercises) {
+            ctx.exerciseCount[ex.index]++;
+        }
+        const WorkoutSession& session=improved.emplace_back(plan[i].getDay(), catalog, move(days[i].exercises),
+                                                            plan[i].getSessionType(), ctx.user.weight,
+                                                            plan[i].getSessionName());
+        ctx.fatigue.train(session.getDay(), session.getMuscleMask());
+    }
+    ctx.repeatPoolReady=false;
+    return improved;
+}
+
+//A day of the updated plan, kept is the session it had before if any
+struct UpdateSlot {
+    Weekday day;
+    Weekday previousDay;   //where the kept session was before a move
+    string focus;
+    const WorkoutSession* kept;
+    bool rebuild;
+};
+
+vector<WorkoutSession> WorkoutPlanner::updatePlan(const vector<WorkoutSession>& previous, const PlanDelta& delta, PlanContext& ctx) const {
+    bool wasOneDay=ctx.user.hasOneDay();
+    if(!applyDelta(ctx.user, delta)) return previous;
+    const User& user=ctx.user;
+
+    //one day plans are picked differently, so those just get made again
+    if(!catalog || catalog->empty() || previous.empty() || wasOneDay || user.hasOneDay()) {
+        return makePlan(ctx);
+    }
+    ScratchScope scope(ctx.scratchArena());
+    preparePool(ctx);
+
+    array<const WorkoutSession*, DAYS_IN_WEEK> byDay{};
+    FatigueState fatigueBefore;
+    for(const WorkoutSession& session : previous) {
+        byDay[session.getDay()]=&session;
+        fatigueBefore.train(session.getDay(), session.getMuscleMask());
+    }
+
+    //sessions that need equipment the user no longer has are picked again for the same focus
+    EquipmentMask owned=ownedEquipment(user);
+    pmr::vector<UpdateSlot> slots(ctx.scratch());
+    for(Weekday day : daysOf(user.workoutDays)) {
+        Weekday from=(delta.kind==DeltaKind::MOVE_DAY && day==delta.toDay) ? delta.day : day;
+        UpdateSlot slot{day, from, "", nullptr, true};
+        if(byDay[from]) {
+            slot.kept=byDay[from];
+            slot.focus=sessionFocus(*slot.kept);
+            slot.rebuild=false;
+            for(const PlannedExercise& ex : slot.kept->getExercises()) {
+                if(!catalog->getTable().canDo(ex.index, owned)) slot.rebuild=true;
             }
-            vector<Exercise> secondaryExs=filterMuscles(available, secondary);
-            secondaryExs=limitRepeats(secondaryExs);
-            if (!secondaryExs.empty()) {
-                shuffle(secondaryExs.begin(), secondaryExs.end(), rng);
-                int needed=5-dayExercises.size();
-                for(int i=0; i<needed && i<secondaryExs.size(); i++) {
-                    dayExercises.push_back(secondaryExs[i]);
+        }
+        slots.push_back(slot);
+    }
+
+    //Focuses a new plan would use for this many days. Kept sessions hold on to theirs while it is still
+    //wanted, the rest are handed out by priority to new days and sessions whose focus isn't wanted anymore.
+    vector<string> allMuscles=priorityMuscles(user);
+    pmr::vector<string> wanted(ctx.scratch());
+    for(size_t i=0; i<slots.size(); i++) {
+        wanted.push_back(dayFocus(i, allMuscles, user));
+    }
+    for(UpdateSlot& slot : slots) {
+        auto it=slot.kept ? find(wanted.begin(), wanted.end(), slot.focus) : wanted.end();
+        if(it!=wanted.end()) {
+            wanted.erase(it);
+        } else {
+            slot.focus.clear();
+            slot.rebuild=true;
+        }
+    }
+    for(UpdateSlot& slot : slots) {
+        if(slot.focus.empty() && !wanted.empty()) {
+            slot.focus=wanted.front();
+            wanted.erase(wanted.begin());
+        }
+    }
+
+    ctx.exerciseCount.clear();
+    ctx.fatigue.clear();
+    for(const UpdateSlot& slot : slots) {
+        if(slot.rebuild) continue;
+        for(const PlannedExercise& ex : slot.kept->getExercises()) {
+            ctx.exerciseCount[ex.index]++;
+        }
+        ctx.fatigue.train(slot.day, slot.kept->getMuscleMask());
+    }
+
+    //Slots are in week order so a day is decided before the days after check it for recovery. A kept day
+    //is only picked again when muscles it trains are now still recovering that weren't before the edit.
+    pmr::vector<optional<WorkoutSession>> sessions(slots.size(), ctx.scratch());
+    for(size_t i=0; i<slots.size(); i++) {
+        UpdateSlot& slot=slots[i];
+        if(!slot.rebuild) {
+            MuscleMask mine=slot.kept->getMuscleMask();
+            MuscleMask now=ctx.fatigue.fatigued(slot.day);
+            MuscleMask before=fatigueBefore.fatigued(slot.previousDay);
+            if(mine & now & ~before) {
+                slot.rebuild=true;
+                for(const PlannedExercise& ex : slot.kept->getExercises()) {
+                    ctx.exerciseCount[ex.index]--;
                 }
+                ctx.fatigue.forget(slot.day);
+                ctx.repeatPoolReady=false;
             }
         }
 
-        dayExercises=ensureMin(dayExercises, 5);
-
-        //Sets exercise times based on training goal.
-        //If the users training goal is Endurance, its sets and time between setss would be very different from Strength (no recommened for beginners)
-        for(Exercise& ex : dayExercises) {
-            ex.estimatedDurationMinutes=getTime(ex, user.goal);
+        if(!slot.rebuild) {
+            //same exercises, the day changes when it was moved
+            span<const PlannedExercise> kept=slot.kept->getExercises();
+            sessions[i].emplace(slot.day, catalog, vector<PlannedExercise>(kept.begin(), kept.end()),
+                                slot.kept->getSessionType(), user.weight, slot.kept->getSessionName());
+            continue;
+        }
+        vector<PlannedExercise> planned=buildSession(slot.day, slot.focus, allMuscles, ctx);
+        if(!planned.empty()) {
+            sessions[i]=finishSession(slot.day, slot.focus, move(planned), ctx);
         }
-        dayExercises=limitTime(dayExercises, 45, 90);
+    }
 
-        if(!dayExercises.empty()) {
-            string sessionName=primaryMuscle+" Day";
-            SessionType sessionType=SessionType::STRENGTH;
+    vector<WorkoutSession> plan;
+    plan.reserve(sessions.size());
+    for(optional<WorkoutSession>& session : sessions) {
+        if(session) plan.push_back(move(*session));
+    }
+    return plan;
+}
 
-            WorkoutSession session(day, dayExercises, sessionType, user.weight);
-            session.setSessionName(sessionName);
-            plan.push_back(session);
+//uses one pool sized to the machine for every batch
+vector<PlanResult> WorkoutPlanner::makePlans(span<const User> users) const {
+    static ThreadPool pool;
+    return makePlans(users, pool);
+}
 
-            lastTrained[day]=session.getMuscles();
-            for(const Exercise& ex : dayExercises) {
-                exerciseCount[ex.name]++;
-            }
+vector<PlanResult> WorkoutPlanner::makePlans(span<const User> users, ThreadPool& pool) const {
+    vector<PlanResult> results(users.size());
+    auto planFor=[this, &users, &results](size_t i) {
+        try {
+            PlanContext ctx(users[i]);
+            results[i].plan=makePlan(ctx);
+        } catch (const exception& e) {
+            results[i].error=e.what();
+        } catch (...) {
+            results[i].error="Unknown error";
         }
+    };
+
+    //a task of this pool waiting for the batch would hold a worker the batch may need, so it plans inline
+    if (pool.onWorker()) {
+        for (size_t i=0; i<users.size(); i++) planFor(i);
+        return results;
     }
-    return plan;
+
+    latch done(users.size());
+    for (size_t i=0; i<users.size(); i++) {
+        pool.submit([&planFor, &done, i] {
+            planFor(i);
+            done.count_down();
+        });
+    }
+    done.wait();
+    return results;
 }
 
 //Creates a  workout for people with only one day available, by chossing compound workouts
-vector<Exercise> WorkoutPlanner::makeDay() {
-    vector<Exercise> compounds=getCompounds();
-    vector<Exercise> available=filterEquipment(compounds);
+vector<PlannedExercise> WorkoutPlanner::makeDay() {
+    return makeDay(context);
+}
+
+vector<PlannedExercise> WorkoutPlanner::makeDay(PlanContext& ctx) const {
+    if(!catalog) return {};
+    ScratchScope scope(ctx.scratchArena());
+    preparePool(ctx);
+    return buildDay(ctx);
+}
+
+//picks the day from the pool makePlan or makeDay prepared
+vector<PlannedExercise> WorkoutPlanner::buildDay(PlanContext& ctx) const {
+    const vector<uint32_t>& available=ctx.pool->compounds;
+    uint32_t index;
     if(available.empty()) {
         // Fallback - use any exercises
-        vector<Exercise> all=filterEquipment(exercises);
-        shuffle(all.begin(), all.end(), rng);
-        vector<Exercise> selected;
-
-        unordered_set<string> covered;
-        for (const Exercise& ex : all) {
-            if(selected.size()>=5) break;
-            bool addedNew=false;
-            for(const string& muscle : ex.muscleGroups) {
-                if (covered.find(muscle)==covered.end()){
-                    addedNew=true;
-                    covered.insert(muscle);
-                }
-            }
+        Sampler picks(ctx.pool->exercises, ctx.scratch());
+        vector<PlannedExercise> selected;
+
+        MuscleMask covered=0;
+        while (selected.size()<5 && picks.next(ctx.rng, index)) {
+            const Exercise& ex=catalog->get(index);
+            bool addedNew=(ex.muscleMask & ~covered)!=0;
+            covered|=ex.muscleMask;
             if(addedNew || selected.size()<3) {
-                selected.push_back(ex);
+                selected.push_back({index, ex.estimatedDurationMinutes});
             }
         }
 
         return selected;
     }
 
-    shuffle(available.begin(), available.end(), rng);
-    vector<Exercise> selected;
-
-    for(int i=0; i<min(5, (int)available.size()); i++) {
-        selected.push_back(available[i]);
-    }
+    Sampler picks(available, ctx.scratch());
+    vector<PlannedExercise> selected;
 
-    for(Exercise& ex : selected) {
-        ex.estimatedDurationMinutes=getTime(ex, user.goal);
+    while (selected.size()<5 && picks.next(ctx.rng, index)) {
+        selected.push_back({index, getTime(catalog->get(index), ctx.user.goal)});
     }
     return selected;
 }
@@ -623,6 +813,10 @@ string priorityText(Priority p) {
 }
 
 void WorkoutPlanner::showAnalysis() const {
+    showAnalysis(context.user);
+}
+
+void WorkoutPlanner::showAnalysis(const User& user) const {
     cout << "\n" << string(40, '=') << "\n";
     cout << "         ANALYSIS RESULTS\n";
     cout << string(40, '=') << "\n";
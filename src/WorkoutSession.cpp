@@ -5,7 +5,7 @@
 #include "WorkoutSession.h"
 #include <iostream>
 #include <iomanip>
-#include <unordered_set>
+#include <bit>
 
 using namespace std;
 
@@ -24,18 +24,23 @@ double getMET(SessionType type){
     }
 }
 
-WorkoutSession::WorkoutSession(const string& workoutDay, const vector<Exercise>& exs,
-                               SessionType sessionType, double userWeight)
-    : day(workoutDay), exercises(exs), type(sessionType), weight(userWeight) {
-    name=getTypeString();
+WorkoutSession::WorkoutSession(Weekday workoutDay, shared_ptr<const ExerciseCatalog> exerciseCatalog,
+                               vector<PlannedExercise> exs, SessionType sessionType, double userWeight,
+                               string sessionName)
+    : day(workoutDay), name(move(sessionName)), catalog(move(exerciseCatalog)), exercises(move(exs)),
+      type(sessionType), weight(userWeight), muscles(0) {
+    if (name.empty()) name=getTypeString();
+    for (const PlannedExercise& ex : exercises) {
+        muscles|=catalog->get(ex.index).muscleMask;
+    }
     calcStats();
 }
 
 //CalculateS total time and calories of workout
 void WorkoutSession::calcStats() {
     duration=0;
-    for(const Exercise& ex : exercises) {
-        duration+=ex.estimatedDurationMinutes;
+    for(const PlannedExercise& ex : exercises) {
+        duration+=ex.duration;
     }
     double hours=duration/60.0;
     double MET=getMET(type);
@@ -47,25 +52,32 @@ bool WorkoutSession::tooLong(int maxTime) const {
 }
 
 //Gets all muscle groups trained in this session to keep track of
-vector<string> WorkoutSession::getMuscles() const {
-    unordered_set<string> muscles;
-    for (const Exercise& ex : exercises) {
-        for(const string& muscle : ex.muscleGroups) {
-            muscles.insert(muscle);
-        }
-    }
-    return vector<string>(muscles.begin(), muscles.end());
+MuscleMask WorkoutSession::getMuscleMask() const {
+    return muscles;
+}
+
+MuscleNameView WorkoutSession::getMuscles() const {
+    return MuscleNameView(muscles);
 }
-string WorkoutSession::getDay() const {
+Weekday WorkoutSession::getDay() const {
     return day;
 }
-string WorkoutSession::getSessionName() const {
+const string& WorkoutSession::getSessionName() const {
     return name;
 }
 
-vector<Exercise> WorkoutSession::getExercises() const {
+span<const PlannedExercise> WorkoutSession::getExercises() const {
     return exercises;
 }
+size_t WorkoutSession::exerciseCount() const {
+    return exercises.size();
+}
+ExerciseView WorkoutSession::exercise(size_t i) const {
+    return catalog->view(exercises[i].index);
+}
+const ExerciseCatalog& WorkoutSession::getCatalog() const {
+    return *catalog;
+}
 
 SessionType WorkoutSession::getSessionType() const {
     return type;
@@ -79,9 +91,13 @@ int WorkoutSession::getCaloriesBurned() const {
 void WorkoutSession::setSessionName(const string& sessionName) {
     name=sessionName;
 }
+void WorkoutSession::setUserWeight(double userWeight) {
+    weight=userWeight;
+    calcStats();
+}
 
 //gets the workoutsession type name
-string WorkoutSession::getTypeString() const {
+string_view WorkoutSession::getTypeString() const {
     switch(type) {
         case SessionType::STRENGTH:
             return "Strength";
@@ -98,19 +114,21 @@ string WorkoutSession::getTypeString() const {
 // Print workout details
 void WorkoutSession::show() const {
     cout<< "\n" << string(40, '-') << "\n";
-    cout<<"Day: " << day << "\n";
+    cout<<"Day: " << weekdayName(day) << "\n";
     cout<<"Session: " << name<< "\n";
     cout<<"Type: " << getTypeString()<< "\n";
     cout<<"Duration: " << duration <<" minutes\n";
     cout<<"Calories: " << calories <<" kcal\n";
     cout<<"Exercises (" << exercises.size() << "):\n";
-    for(const Exercise& ex : exercises) {
-        cout << " - " << ex.name << " (" << ex.estimatedDurationMinutes << " min)\n";
-        cout << "   Equipment: " << ex.equipment << "\n";
+    for(const PlannedExercise& planned : exercises) {
+        ExerciseView ex=catalog->view(planned.index);
+        cout << " - " << ex.name() << " (" << planned.duration << " min)\n";
+        cout << "   Equipment: " << ex.equipment() << "\n";
         cout << "   Muscles: ";
-        for(size_t i=0; i<ex.muscleGroups.size(); ++i) {
-            cout << ex.muscleGroups[i];
-            if (i<ex.muscleGroups.size()-1) cout << ", ";
+        span<const uint8_t> muscles=ex.get().listedMuscles();
+        for(size_t i=0; i<muscles.size(); ++i) {
+            cout << muscleName(muscles[i]);
+            if (i<muscles.size()-1) cout << ", ";
         }
         cout << "\n";
     }
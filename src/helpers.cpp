@@ -2,13 +2,14 @@
 //vector of all exercises
 #include "Exercise.h"
 #include "helpers.h"
+#include "CatalogLoader.h"
 #include <fstream>
 #include <algorithm>
 #include <sstream>
 #include <iostream>
 
 //Loads the exercises from JSON file
-vector<Exercise> loadDatabase(const string& filename) {
+vector<Exercise> loadDatabase(const string& filename, EquipmentVocab& vocab, ExerciseStore& store) {
     vector<Exercise> exercises;
     ifstream file(filename);
 
@@ -17,30 +18,12 @@ vector<Exercise> loadDatabase(const string& filename) {
         return exercises;
     }
 
-    try {
-        json j;
-        file >> j;
-
-        if (!j.is_array()) {
-            cerr << "Error: Invalid JSON format."<<endl;
-            return exercises;
-        }
-
-        for(const auto& item : j) {
-            if(item.contains("exercise") && item.contains("muscle_groups") && item.contains("equipment")) {
-                exercises.push_back(Exercise::from_json(item));
-            } else {
-                cerr << "Warning: Skipping invalid exercise."<<endl;
-            }
-        }
-
-        cout << "Loaded "<<exercises.size() <<" exercises from "<< filename << endl;
-
-    } catch(const json::exception& e) {
-        cerr << "Error parsing file: " << e.what() << endl;
-        return {};
-    }
+    bool ok=streamExercises(file, vocab, store, [&exercises](Exercise&& ex) {
+        exercises.push_back(move(ex));
+    });
+    if (!ok) return {};
 
+    cout << "Loaded "<<exercises.size() <<" exercises from "<< filename << endl;
     return exercises;
 }
 
@@ -60,17 +43,12 @@ string formatText(const unordered_map<string, string>& data) {
 }
 
 //Checks if user has required equipment for a workout
+//"+" needs all of the items, "/" and "or" need any of them
 bool hasEquipment(const string& needed, const unordered_set<string>& owned) {
-    if(needed=="Bodyweight") return true;  // everyone can do bodyweight
-
-    string neededLower=toLowerCase(needed);
-    for(const string& item : owned) {
-        string itemLower=toLowerCase(item);
-        if (neededLower.find(itemLower)!=string::npos ||
-            itemLower.find(neededLower)!=string::npos) {
-            return true;
-        }
-    } return false;
+    EquipmentVocab vocab;
+    EquipmentReq req=vocab.parse(needed);
+    if (vocab.overflowed()) return false;
+    return req.satisfiedBy(vocab.ownedMask(owned));
 }
 
 // Equipment categories mapping
@@ -122,13 +100,19 @@ bool checkDuration(const vector<Exercise>& exercises, int minTime, int maxTime)
     return total>=minTime && total<=maxTime;
 }
 
-// Count exercises by muscle group
-unordered_map<string, int> countMuscles(const vector<Exercise>& exercises) {
-    unordered_map<string, int> count;
+bool checkDuration(const vector<PlannedExercise>& exercises, int minTime, int maxTime) {
+    int total=0;
+    for(const PlannedExercise& ex : exercises) {
+        total += ex.duration+2;
+    }
+    return total>=minTime && total<=maxTime;
+}
+
+// Count exercises by muscle group, indexed by muscle id
+MuscleHistogram countMuscles(const vector<Exercise>& exercises) {
+    MuscleHistogram count{};
     for(const Exercise& ex : exercises) {
-        for (const string& muscle : ex.muscleGroups) {
-            count[muscle]++;
-        }
+        addMuscles(count, ex.muscleMask);
     }
     return count;
 }
\ No newline at end of file
@@ -1,15 +1,73 @@
 #include "WorkoutPlanner.h"
 #include "User.h"
 #include "helpers.h"
+#include "CatalogSnapshot.h"
+#include "EmbeddedCatalog.h"
+#include "PlanSerializer.h"
 #include <iostream>
+#include <cstdio>
 #include <unordered_set>
 #include <map>
 
-int main() {
+//Compiles the JSON database into a binary snapshot that loads without parsing:
+//  planner --compile-catalog exercise_database.json exercise_database.bin
+int compileCatalog(const string& input, const string& output) {
+    auto catalog = ExerciseCatalog::load(input);
+    if (!catalog || !saveSnapshot(*catalog, output)) {
+        std::cerr << "Failed to compile catalog.\n";
+        return 1;
+    }
+    cout << "Wrote " << catalog->size() << " exercises to " << output << "\n";
+    return 0;
+}
+
+//Generates the tables for building the catalog into the program:
+//  planner --embed-catalog exercise_database.json src/EmbeddedCatalogData.inc
+int embedCatalog(const string& input, const string& output) {
+    auto catalog = ExerciseCatalog::load(input);
+    if (!catalog || !writeEmbeddedCatalog(*catalog, output)) {
+        std::cerr << "Failed to embed catalog.\n";
+        return 1;
+    }
+    cout << "Wrote " << catalog->size() << " exercises to " << output << "\n";
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc == 4 && string(argv[1]) == "--compile-catalog") {
+        return compileCatalog(argv[2], argv[3]);
+    }
+    if (argc == 4 && string(argv[1]) == "--embed-catalog") {
+        return embedCatalog(argv[2], argv[3]);
+    }
+
+    //planner --format json|ndjson|csv|binary [catalog] prints only the plan in that format
+    PlanFormat format;
+    bool formatted = false;
+    if (argc >= 3 && string(argv[1]) == "--format") {
+        if (!planFormatOf(argv[2], format)) {
+            std::cerr << "Unknown plan format: " << argv[2] << "\n";
+            return 1;
+        }
+        formatted = true;
+        argv += 2;
+        argc -= 2;
+        //status messages go to stderr so stdout is only the plan
+        cout.rdbuf(cerr.rdbuf());
+    }
+
     WorkoutPlanner planner;
 
-    // Load exercise data
-    if (!planner.loadData("exercise_database.json")) {
+    // Load exercise data, a snapshot made with --compile-catalog can be passed instead of the JSON.
+    // Builds with the catalog compiled in only read a file when one is passed.
+    bool loaded;
+    if (argc == 1 && hasEmbeddedCatalog()) {
+        planner.setCatalog(embeddedCatalog());
+        loaded = true;
+    } else {
+        loaded = planner.loadData(argc > 1 ? argv[1] : "exercise_database.json");
+    }
+    if (!loaded) {
         std::cerr << "Failed to load data.\n";
         return 1;
     }
@@ -43,19 +101,25 @@ int main() {
 
     Goal goal = Goal::STRENGTH_BUILD;
 
-    User user(name, height, weight, age, gender, days, equipment, priorities, goal);
+    User user(name, height, weight, age, gender, dayMaskOf(days), equipment, priorities, goal);
 
     planner.setUser(user);
 
     // Generate plan
     auto plan = planner.makePlan();
+    if (formatted) {
+        string out;
+        if (!writePlan(plan, format, out)) return 1;
+        fwrite(out.data(), 1, out.size(), stdout);
+        return 0;
+    }
     planner.showPlan(plan);
     planner.showAnalysis();
 
     // Summary
     cout << "\n=== PLAN SUMMARY ===\n";
     for (const auto& session : plan) {
-        cout << session.getDay() << ": " << session.getSessionName()
+        cout << weekdayName(session.getDay()) << ": " << session.getSessionName()
              << " (" << session.getDuration()<<" min, "
              << session.getExercises().size()<<" exercises)\n";
     }
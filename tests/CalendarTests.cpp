@@ -0,0 +1,93 @@
+#include "Check.h"
+#include "Calendar.h"
+#include "PlanWeeks.h"
+#include "User.h"
+
+using namespace chrono;
+
+TEST(weekTablesMatchWalkingBack) {
+    for (int days = 0; days < 128; days++) {
+        for (int day = 0; day < DAYS_IN_WEEK; day++) {
+            int previous = DAYS_IN_WEEK, gap = 0, ahead = 0;
+            for (int back = 1; back <= DAYS_IN_WEEK && !gap; back++) {
+                int before = (day - back + DAYS_IN_WEEK) % DAYS_IN_WEEK;
+                if (days & dayBit(before)) previous = before, gap = back;
+            }
+            while (days && !(days & dayBit((day + ahead) % DAYS_IN_WEEK))) ahead++;
+            CHECK(previousTrainingDay(days, day) == previous);
+            CHECK(restGap(days, day) == gap);
+            CHECK(nextGap(days, day) == ahead);
+        }
+    }
+}
+
+TEST(weekdayOfDates) {
+    CHECK(weekdayOf(sys_days(2024y / January / 1)) == MONDAY);
+    CHECK(weekdayOf(sys_days(2024y / March / 3)) == SUNDAY);
+    CHECK(weekdayOf(sys_days(2026y / October / 17)) == SATURDAY);
+}
+
+//every schedule lookup against checking trainsOn a day at a time
+TEST(scheduleLookupsMatchDayByDay) {
+    sys_days first = 2024y / January / 10;
+    vector<TrainingSchedule> schedules = {
+        TrainingSchedule::weekly(dayBit(MONDAY) | dayBit(THURSDAY)),
+        TrainingSchedule::weekly(dayBit(SUNDAY)),
+        TrainingSchedule::everyNDays(3, first),
+        TrainingSchedule::everyNDays(1, first),
+        TrainingSchedule::everyNDays(9, first),
+    };
+    for (const TrainingSchedule& schedule : schedules) {
+        for (sys_days date = first - days(20); date < first + days(60); date += days(1)) {
+            sys_days previous = date;
+            for (sys_days d = date - days(1); d >= first - days(40); d -= days(1)) {
+                if (schedule.trainsOn(d)) {
+                    previous = d;
+                    break;
+                }
+            }
+            sys_days next = date;
+            while (!schedule.trainsOn(next)) next += days(1);
+            CHECK(schedule.previous(date) == previous);
+            CHECK(schedule.next(date) == next);
+
+            vector<sys_days> expected;
+            for (sys_days d = date; d < date + days(10); d += days(1)) {
+                if (schedule.trainsOn(d)) expected.push_back(d);
+            }
+            CHECK(schedule.between(date, date + days(10)) == expected);
+
+            DayMask week = 0;
+            sys_days monday = date - days(weekdayOf(date));
+            for (int day = 0; day < DAYS_IN_WEEK; day++) {
+                if (schedule.trainsOn(monday + days(day))) week |= dayBit(day);
+            }
+            CHECK(schedule.weekOf(date) == week);
+        }
+    }
+}
+
+//an every 3rd day schedule moves through the weekdays, each week plans the days it lands on
+TEST(planWeeksFollowSchedule) {
+    auto catalog = ExerciseCatalog::load("exercise_database.json");
+    CHECK(catalog != nullptr);
+    if (!catalog) return;
+    WorkoutPlanner planner(catalog);
+    User user("Test", 180, 80, 30, "Male", dayBit(MONDAY), {"Barbell", "Dumbbells", "Bench"},
+              {{"Chest", Priority::HIGH}}, Goal::MUSCLE_BUILD);
+    sys_days first = 2024y / January / 3;   //a Wednesday
+    TrainingSchedule schedule = TrainingSchedule::everyNDays(3, first);
+
+    PlanWeeks weeks(planner, PlanContext(user, 5), schedule, first, 4);
+    for (const vector<WorkoutSession>& week : weeks) {
+        sys_days monday = weeks.weekStart();
+        CHECK(weekdayOf(monday) == MONDAY);
+        vector<sys_days> dates = schedule.between(max(monday, first), monday + days(DAYS_IN_WEEK));
+        CHECK(week.size() == dates.size());
+        for (size_t i = 0; i < week.size() && i < dates.size(); i++) {
+            CHECK(week[i].getDay() == weekdayOf(dates[i]));
+        }
+    }
+    CHECK(weeks.weekNumber() == 4);
+    CHECK(weeks.weekStart() == sys_days(2024y / January / 22));
+}
@@ -0,0 +1,59 @@
+#include "Check.h"
+#include "CatalogLoader.h"
+#include "ExerciseCatalog.h"
+#include <string>
+#include <algorithm>
+
+//Every exercise needs two of the items and either of two others, picked so each chunk of a parallel
+//load sees the items in a different order and its own ids differ from the shared ones.
+static string mixedCatalog(int items, int exercises) {
+    string text = "[";
+    for (int i = 0; i < exercises; i++) {
+        auto item = [&](int k) { return "Gadget " + to_string((k % items + items) % items); };
+        if (i > 0) text += ",";
+        text += "{\"exercise\":\"Move " + to_string(i) + "\",\"muscle_groups\":[\"Chest\"],"
+                "\"equipment\":\"" + item(items - 1 - i) + " + " + item(i * 7) + " / " +
+                item(i * 13 + 5) + "\"}";
+    }
+    return text + "]";
+}
+
+//the parallel loader has to end up with the same vocab and masks as the streaming one
+static void checkSameCatalog(const ExerciseCatalog& streamed, const ExerciseCatalog& parallel) {
+    const EquipmentVocab& vocab = streamed.getEquipmentVocab();
+    CHECK(parallel.getEquipmentVocab().size() == vocab.size());
+    for (size_t id = 0; id < vocab.size() && id < parallel.getEquipmentVocab().size(); id++) {
+        CHECK(parallel.getEquipmentVocab().name(id) == vocab.name(id));
+    }
+
+    CHECK(parallel.size() == streamed.size());
+    for (size_t i = 0; i < streamed.size() && i < parallel.size(); i++) {
+        CHECK(streamed.view(i).name() == parallel.view(i).name());
+        CHECK(ranges::equal(streamed.view(i).equipmentOptions(), parallel.view(i).equipmentOptions()));
+    }
+    for (size_t id = 1; id < vocab.size(); id++) {
+        EquipmentMask owned = vocab.ownedMask({vocab.name(id), vocab.name(id % (vocab.size() - 1) + 1)});
+        CHECK(streamed.equipmentExercises(owned) == parallel.equipmentExercises(owned));
+    }
+}
+
+TEST(catalogLoadersMatchOnFullVocab) {
+    string path = writeTempFile("mixed64.json", mixedCatalog(63, 400));
+    auto streamed = ExerciseCatalog::load(path);
+    CHECK(streamed != nullptr);
+    if (!streamed) return;
+    CHECK(streamed->getEquipmentVocab().size() == EquipmentVocab::MAX_BITS);
+    for (size_t threads : {1, 3, 8}) {
+        auto parallel = loadCatalogParallel(path, threads);
+        CHECK(parallel != nullptr);
+        if (parallel) checkSameCatalog(*streamed, *parallel);
+    }
+}
+
+TEST(catalogLoadersRejectTooManyItems) {
+    string path = writeTempFile("mixed70.json", mixedCatalog(70, 400));
+    CHECK(ExerciseCatalog::load(path) == nullptr);
+    for (size_t threads : {1, 3, 8}) {
+        CHECK(loadCatalogParallel(path, threads) == nullptr);
+    }
+}
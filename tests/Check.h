@@ -0,0 +1,28 @@
+#ifndef CHECK_H
+#define CHECK_H
+
+#include <string>
+#include <functional>
+
+using namespace std;
+
+//Small self registering checks so the tests build the same way the benchmark does, without a framework.
+//Every file adds its cases with TEST(name) { ... } and CHECK(condition) records a failure and keeps going.
+struct TestCase {
+    TestCase(const char* name, function<void()> body);
+};
+
+void checkFailed(const char* file, int line, const char* condition);
+
+#define CHECK(condition) \
+    do { if (!(condition)) checkFailed(__FILE__, __LINE__, #condition); } while (0)
+
+#define TEST(name) \
+    static void name(); \
+    static TestCase name##Case(#name, name); \
+    static void name()
+
+//writes text to a file in the temp directory and returns its path
+string writeTempFile(const string& name, const string& text);
+
+#endif
@@ -0,0 +1,45 @@
+#include "Check.h"
+#include "EmbeddedCatalog.h"
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+
+static string readFile(const string& path) {
+    ifstream file(path, ios::binary);
+    stringstream text;
+    text << file.rdbuf();
+    return text.str();
+}
+
+//the tables are committed with the source, this fails once they no longer match the database
+//and src/EmbeddedCatalogData.inc has to be generated again (see the README)
+TEST(embeddedTablesMatchDatabase) {
+    auto catalog = ExerciseCatalog::load("exercise_database.json");
+    CHECK(catalog != nullptr);
+    if (!catalog) return;
+    string path = writeTempFile("embedded.inc", "");
+    CHECK(writeEmbeddedCatalog(*catalog, path));
+    CHECK(readFile(path) == readFile("src/EmbeddedCatalogData.inc"));
+}
+
+//only runs in a build with -DSWP_EMBEDDED_CATALOG
+TEST(embeddedCatalogMatchesJson) {
+    if (!hasEmbeddedCatalog()) return;
+    auto json = ExerciseCatalog::load("exercise_database.json");
+    auto embedded = embeddedCatalog();
+    CHECK(json != nullptr && embedded != nullptr);
+    if (!json || !embedded) return;
+
+    CHECK(embedded->size() == json->size());
+    for (size_t i = 0; i < json->size() && i < embedded->size(); i++) {
+        ExerciseView a = json->view(i), b = embedded->view(i);
+        CHECK(a.name() == b.name());
+        CHECK(a.equipment() == b.equipment());
+        CHECK(a.equipmentCategory() == b.equipmentCategory());
+        CHECK(a.get().muscleMask == b.get().muscleMask);
+        CHECK(ranges::equal(a.get().listedMuscles(), b.get().listedMuscles()));
+        CHECK(a.get().estimatedDurationMinutes == b.get().estimatedDurationMinutes);
+        CHECK(a.get().isCompound == b.get().isCompound);
+        CHECK(ranges::equal(a.equipmentOptions(), b.equipmentOptions()));
+    }
+}
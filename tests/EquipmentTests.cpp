@@ -0,0 +1,55 @@
+#include "Check.h"
+#include "ExerciseCatalog.h"
+#include "Equipment.h"
+#include <string>
+
+//one exercise per item, "Gadget 1" to "Gadget count"
+static string gadgetCatalog(int count) {
+    string text = "[";
+    for (int i = 1; i <= count; i++) {
+        if (i > 1) text += ",";
+        text += "{\"exercise\":\"Move " + to_string(i) + "\",\"muscle_groups\":[\"Chest\"],"
+                "\"equipment\":\"Gadget " + to_string(i) + "\"}";
+    }
+    return text + "]";
+}
+
+TEST(equipmentParsesToOptions) {
+    EquipmentVocab vocab;
+    EquipmentReq req = vocab.parse("Barbell / Dumbbells + Bench");
+    CHECK(req.options.size() == 2);
+    CHECK(req.satisfiedBy(vocab.ownedMask({"Dumbbell", "Bench"})));
+    CHECK(!req.satisfiedBy(vocab.ownedMask({"Dumbbell"})));
+    CHECK(!vocab.overflowed());
+}
+
+//bodyweight and 63 gadgets are exactly 64 items, every one has to keep its own bit
+TEST(equipmentFullVocabKeepsItemsApart) {
+    EquipmentVocab vocab;
+    vector<EquipmentReq> reqs;
+    for (int i = 1; i <= 63; i++) {
+        reqs.push_back(vocab.parse("Gadget " + to_string(i)));
+    }
+    CHECK(vocab.size() == EquipmentVocab::MAX_BITS);
+    CHECK(!vocab.overflowed());
+    for (int i = 1; i <= 63; i++) {
+        EquipmentMask owned = vocab.ownedMask({"Gadget " + to_string(i)});
+        for (int j = 1; j <= 63; j++) {
+            CHECK(reqs[j - 1].satisfiedBy(owned) == (i == j));
+        }
+    }
+}
+
+TEST(equipmentOverflowRejectsCatalog) {
+    EquipmentVocab vocab;
+    for (int i = 1; i < EquipmentVocab::MAX_BITS; i++) {
+        CHECK(vocab.intern("Gadget " + to_string(i)) == i);
+    }
+    CHECK(vocab.intern("Gadget 1") == 1);
+    CHECK(!vocab.overflowed());
+    CHECK(vocab.intern("One Too Many") == -1);
+    CHECK(vocab.overflowed());
+
+    CHECK(ExerciseCatalog::load(writeTempFile("gadgets70.json", gadgetCatalog(70))) == nullptr);
+    CHECK(ExerciseCatalog::load(writeTempFile("gadgets63.json", gadgetCatalog(63))) != nullptr);
+}
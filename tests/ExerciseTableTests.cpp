@@ -0,0 +1,67 @@
+#include "Check.h"
+#include "ExerciseTable.h"
+#include "ExerciseStore.h"
+#include <random>
+#include <algorithm>
+
+//Rows the filter keeps, worked out from the records one at a time. The table scan has to give the
+//same selection on the AVX2 path (build with -mavx2) and on the plain loop.
+static vector<uint32_t> referenceScan(span<const Exercise> exercises, const ExerciseStore& store, const TableFilter& filter) {
+    vector<uint32_t> rows;
+    for (uint32_t row = 0; row < exercises.size(); row++) {
+        const Exercise& ex = exercises[row];
+        if (filter.muscles && !(ex.muscleMask & filter.muscles)) continue;
+        if (filter.compoundOnly && !ex.isCompound) continue;
+        if (find(filter.exclude.begin(), filter.exclude.end(), row) != filter.exclude.end()) continue;
+        span<const EquipmentMask> options = store.options(ex.firstOption, ex.optionCount);
+        if (any_of(options.begin(), options.end(), [&](EquipmentMask option) { return (filter.owned & option) == option; })) {
+            rows.push_back(row);
+        }
+    }
+    return rows;
+}
+
+//a few bits set at random, the top bits included so sign extension would show up
+template <typename Mask>
+static Mask randomMask(mt19937_64& rng, int bits) {
+    Mask mask = 0;
+    for (int i = rng() % 4; i > 0; i--) {
+        mask |= Mask(1) << (rng() % bits);
+    }
+    if (rng() % 8 == 0) mask |= Mask(1) << (bits - 1);
+    return mask;
+}
+
+TEST(tableScanMatchesReference) {
+    mt19937_64 rng(14);
+    //sizes around the four row step, so the tail loop is covered too
+    for (size_t count : {0, 1, 3, 4, 5, 7, 8, 13, 1001}) {
+        ExerciseStore store;
+        vector<Exercise> exercises(count);
+        for (Exercise& ex : exercises) {
+            ex.muscleMask = randomMask<MuscleMask>(rng, MAX_MUSCLES);
+            ex.isCompound = rng() % 3 == 0;
+            //mostly one option, sometimes none or several
+            vector<EquipmentMask> options(rng() % 5 == 0 ? rng() % 4 : 1);
+            for (EquipmentMask& option : options) {
+                option = randomMask<EquipmentMask>(rng, EquipmentVocab::MAX_BITS);
+            }
+            ex.firstOption = store.addOptions(options);
+            ex.optionCount = options.size();
+        }
+        ExerciseTable table(exercises, store);
+
+        for (int round = 0; round < 200; round++) {
+            TableFilter filter;
+            filter.owned = rng() % 6 == 0 ? ~EquipmentMask(0) : randomMask<EquipmentMask>(rng, 64) | rng();
+            filter.muscles = rng() % 3 == 0 ? 0 : randomMask<MuscleMask>(rng, MAX_MUSCLES);
+            filter.compoundOnly = rng() % 4 == 0;
+            vector<uint32_t> exclude;
+            for (size_t row = 0; row < count; row++) {
+                if (rng() % 5 == 0) exclude.push_back(row);
+            }
+            if (round % 2) filter.exclude = exclude;
+            CHECK(table.scan(filter) == referenceScan(exercises, store, filter));
+        }
+    }
+}
@@ -0,0 +1,90 @@
+#include "Check.h"
+#include "Fatigue.h"
+#include "User.h"
+#include <random>
+
+//fatigued muscles worked out in hours from every training day, last week's days count as day - 7
+static MuscleMask referenceFatigue(const array<MuscleMask, DAYS_IN_WEEK>& lastWeek,
+                                   const array<MuscleMask, DAYS_IN_WEEK>& thisWeek, int day) {
+    MuscleMask result = 0;
+    for (int m = 0; m < MAX_MUSCLES; m++) {
+        for (int trained = -DAYS_IN_WEEK; trained < DAYS_IN_WEEK; trained++) {
+            MuscleMask muscles = trained < 0 ? lastWeek[trained + DAYS_IN_WEEK] : thisWeek[trained];
+            int hours = (day - trained) * 24;
+            if ((muscles & muscleBit(m)) && hours > 0 && hours < FatigueState::recoveryHours(m)) {
+                result |= muscleBit(m);
+            }
+        }
+    }
+    return result;
+}
+
+TEST(fatigueWindows) {
+    FatigueState fatigue;
+    fatigue.train(MONDAY, muscleBit(MUSCLE_CHEST) | muscleBit(MUSCLE_QUADS));
+    CHECK(fatigue.fatigued(MONDAY) == 0);
+    CHECK(fatigue.fatigued(TUESDAY) == (muscleBit(MUSCLE_CHEST) | muscleBit(MUSCLE_QUADS)));
+    CHECK(fatigue.fatigued(WEDNESDAY) == muscleBit(MUSCLE_QUADS));
+    CHECK(fatigue.fatigued(THURSDAY) == 0);
+    CHECK(fatigue.trainedOn(MONDAY) == (muscleBit(MUSCLE_CHEST) | muscleBit(MUSCLE_QUADS)));
+}
+
+//Sunday and Saturday of the week before still count on Monday
+TEST(fatigueWrapsIntoNextWeek) {
+    FatigueState fatigue;
+    fatigue.train(SATURDAY, muscleBit(MUSCLE_GLUTES) | muscleBit(MUSCLE_BACK));
+    fatigue.train(SUNDAY, muscleBit(MUSCLE_CHEST));
+    fatigue.nextWeek();
+    CHECK(fatigue.trainedOn(SUNDAY) == 0);
+    CHECK(fatigue.fatigued(MONDAY) == (muscleBit(MUSCLE_GLUTES) | muscleBit(MUSCLE_CHEST)));
+    CHECK(fatigue.fatigued(TUESDAY) == 0);
+    fatigue.nextWeek();
+    CHECK(fatigue.fatigued(MONDAY) == 0);
+}
+
+TEST(fatigueForgetAndClear) {
+    FatigueState fatigue;
+    fatigue.train(TUESDAY, muscleBit(MUSCLE_BACK));
+    fatigue.train(WEDNESDAY, muscleBit(MUSCLE_CHEST));
+    fatigue.forget(TUESDAY);
+    CHECK(fatigue.trainedOn(TUESDAY) == 0);
+    CHECK(fatigue.fatigued(THURSDAY) == muscleBit(MUSCLE_CHEST));
+    fatigue.clear();
+    CHECK(fatigue.fatigued(THURSDAY) == 0);
+    //days outside the week are ignored
+    fatigue.train(DAYS_IN_WEEK, muscleBit(MUSCLE_CORE));
+    CHECK(fatigue.fatigued(DAYS_IN_WEEK) == 0);
+    CHECK(fatigue.trainedOn(DAYS_IN_WEEK) == 0);
+}
+
+TEST(fatigueMatchesHours) {
+    mt19937 rng(20);
+    for (int round = 0; round < 300; round++) {
+        array<MuscleMask, DAYS_IN_WEEK> lastWeek{}, thisWeek{};
+        FatigueState fatigue;
+        for (int day = 0; day < DAYS_IN_WEEK; day++) {
+            if (rng() % 2) lastWeek[day] = rng();
+            fatigue.train((Weekday)day, lastWeek[day]);
+        }
+        fatigue.nextWeek();
+        for (int day = 0; day < DAYS_IN_WEEK; day++) {
+            if (rng() % 2) thisWeek[day] = rng();
+            fatigue.train((Weekday)day, thisWeek[day]);
+        }
+        for (int day = 0; day < DAYS_IN_WEEK; day++) {
+            CHECK(fatigue.fatigued((Weekday)day) == referenceFatigue(lastWeek, thisWeek, day));
+            CHECK(fatigue.trainedOn((Weekday)day) == thisWeek[day]);
+        }
+    }
+}
+
+TEST(backToBackDaysFromFatigue) {
+    for (int days = 0; days < 128; days++) {
+        User user("Test", 180, 80, 30, "Male", (DayMask)days, {}, {}, Goal::STRENGTH);
+        bool inARow = false;
+        for (int day = 1; day < DAYS_IN_WEEK; day++) {
+            if ((days & dayBit(day)) && (days & dayBit(day - 1))) inARow = true;
+        }
+        CHECK(user.hasBackToDays() == inARow);
+    }
+}
@@ -0,0 +1,65 @@
+#include "Check.h"
+#include "Muscle.h"
+#include "WorkoutPlanner.h"
+#include <ranges>
+
+TEST(muscleLookupNeverAdds) {
+    CHECK(muscleId("Chest") == MUSCLE_CHEST);
+    CHECK(muscleMaskOf("Arms") == ARM_MUSCLES);
+    CHECK(muscleId("Not A Muscle") == -1);
+    CHECK(muscleMaskOf("Not A Muscle") == 0);
+    CHECK(muscleMaskOf("") == 0);
+    CHECK(muscleMaskOf(vector<string>{"Chest", "Nonsense"}) == muscleBit(MUSCLE_CHEST));
+    CHECK(muscleId("Not A Muscle") == -1);
+}
+
+//names from a request only ever look the table up, whatever the user sends
+TEST(muscleRequestNamesStayOut) {
+    WorkoutPlanner planner;
+    CHECK(planner.loadData(writeTempFile("muscles.json",
+        "[{\"exercise\":\"Push Up\",\"muscle_groups\":[\"Chest\"],\"equipment\":\"Bodyweight\"}]")));
+
+    map<string, Priority> priorities = {{"Hostile 1", Priority::HIGH}, {"Hostile 2", Priority::MEDIUM}, {"", Priority::LOW}};
+    User user("x", 170, 70, 25, "Male", dayBit(MONDAY) | dayBit(WEDNESDAY), {"Bodyweight"}, priorities, Goal::MUSCLE_BUILD);
+    PlanContext ctx(user, 1);
+    planner.makePlan(ctx);
+    CHECK(planner.filterMuscles({0}, {"Hostile 3"}).empty());
+
+    CHECK(muscleId("Hostile 1") == -1);
+    CHECK(muscleId("Hostile 2") == -1);
+    CHECK(muscleId("Hostile 3") == -1);
+    CHECK(muscleId("") == -1);
+}
+
+//Fills the process wide table. Only names no other check uses are added, so the order checks run in doesn't matter.
+TEST(muscleFullTableTurnsNamesAway) {
+    int added = 0;
+    for (int i = 0; i < MAX_MUSCLES * 2; i++) {
+        int id = internMuscle("Catalog Muscle " + to_string(i));
+        if (id < 0) break;
+        CHECK(muscleName(id) == "Catalog Muscle " + to_string(i));
+        added++;
+    }
+    CHECK(added < MAX_MUSCLES);
+    CHECK(internMuscle("One Too Many") == -1);
+    CHECK(muscleId("One Too Many") == -1);
+    CHECK(internMuscle("Chest") == MUSCLE_CHEST);
+
+    //an exercise with a name that didn't fit keeps its other muscles and nothing else
+    ExerciseStore store;
+    Exercise ex(store, "Press", {"Chest", "One Too Many"}, "Bodyweight");
+    CHECK(ex.muscleMask == muscleBit(MUSCLE_CHEST));
+    CHECK(ex.listedMuscles().size() == 1);
+}
+
+TEST(muscleNameViewWalksTheMask) {
+    static_assert(ranges::input_range<MuscleNameView>);
+    for (MuscleMask mask : {MuscleMask(0), LOWER_BODY, UPPER_BODY | muscleBit(MUSCLE_CARDIO), muscleBit(MUSCLE_LEGS)}) {
+        MuscleNameView view(mask);
+        vector<string> names;
+        for (const string& name : view) names.push_back(name);
+        CHECK(names == muscleNames(mask));
+        CHECK(view.size() == names.size());
+        CHECK(view.empty() == (mask == 0));
+    }
+}
@@ -0,0 +1,30 @@
+#include "Check.h"
+#include "PlanCache.h"
+#include "User.h"
+
+static User cacheUser(unordered_set<string> equipment, map<string, Priority> priorities) {
+    return User("Test", 180, 80, 30, "Male", dayBit(MONDAY) | dayBit(THURSDAY), move(equipment), move(priorities),
+                Goal::MUSCLE_BUILD);
+}
+
+TEST(planCacheKeySameInputsSameKey) {
+    User a = cacheUser({"Barbell", "Bench"}, {{"Chest", Priority::HIGH}});
+    User b = cacheUser({"Bench", "Barbell"}, {{"Chest", Priority::HIGH}});
+    CHECK(PlanCache::makeKey(a, 7) == PlanCache::makeKey(b, 7));
+    CHECK(PlanCache::makeKey(a, 7) != PlanCache::makeKey(a, 8));
+}
+
+//names holding the separators used to be joined into the same key as other users
+TEST(planCacheKeySeparatorsInNames) {
+    User joined = cacheUser({"Barbell,Bench"}, {});
+    User split = cacheUser({"Barbell", "Bench"}, {});
+    CHECK(PlanCache::makeKey(joined, 1) != PlanCache::makeKey(split, 1));
+
+    User packed = cacheUser({}, {{"Back=0,Chest", Priority::HIGH}});
+    User apart = cacheUser({}, {{"Back", Priority::LOW}, {"Chest", Priority::HIGH}});
+    CHECK(PlanCache::makeKey(packed, 1) != PlanCache::makeKey(apart, 1));
+
+    User piped = cacheUser({"Bench|priorities:"}, {});
+    User plain = cacheUser({"Bench"}, {{"", Priority::LOW}});
+    CHECK(PlanCache::makeKey(piped, 1) != PlanCache::makeKey(plain, 1));
+}
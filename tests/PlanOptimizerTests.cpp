@@ -0,0 +1,45 @@
+#include "Check.h"
+#include "PlanOptimizer.h"
+#include "ExerciseCatalog.h"
+#include "User.h"
+
+//score of one exercise on each of two days, only the recovery cost depends on which days they are
+static int twoDayScore(const PlanOptimizer& optimizer, const vector<uint32_t>& pair, Weekday first, Weekday second) {
+    vector<PlanDay> days = {
+        {first, 0, {{pair[0], 10}}},
+        {second, 0, {{pair[1], 10}}},
+    };
+    return optimizer.score(days);
+}
+
+//two exercises that train exactly these muscles, so the days don't share an exercise
+static vector<uint32_t> pairFor(const ExerciseCatalog& catalog, MuscleMask muscles) {
+    vector<uint32_t> pair;
+    for (uint32_t i = 0; i < catalog.size() && pair.size() < 2; i++) {
+        if (catalog.get(i).muscleMask == muscles) pair.push_back(i);
+    }
+    return pair;
+}
+
+TEST(optimizerRecoveryFollowsFatigueWindows) {
+    auto catalog = ExerciseCatalog::load("exercise_database.json");
+    CHECK(catalog != nullptr);
+    if (!catalog) return;
+    unique_ptr<EligiblePool> pool = catalog->buildPool(~EquipmentMask(0));
+    User user;
+    PlanOptimizer optimizer(*catalog, *pool, user, [](uint32_t) { return 10; }, 0, 1000);
+
+    vector<uint32_t> chest = pairFor(*catalog, muscleBit(MUSCLE_CHEST));
+    vector<uint32_t> quads = pairFor(*catalog, muscleBit(MUSCLE_QUADS));
+    CHECK(chest.size() == 2 && quads.size() == 2);
+    if (chest.size() < 2 || quads.size() < 2) return;
+
+    //48h for chest, so only the day right after costs anything
+    CHECK(twoDayScore(optimizer, chest, MONDAY, TUESDAY) < twoDayScore(optimizer, chest, MONDAY, THURSDAY));
+    CHECK(twoDayScore(optimizer, chest, MONDAY, WEDNESDAY) == twoDayScore(optimizer, chest, MONDAY, THURSDAY));
+    //72h for the lower body, two days later is still too soon
+    CHECK(twoDayScore(optimizer, quads, MONDAY, WEDNESDAY) < twoDayScore(optimizer, quads, MONDAY, THURSDAY));
+    //the week wraps, Sunday is the day before Monday
+    CHECK(twoDayScore(optimizer, chest, MONDAY, SUNDAY) < twoDayScore(optimizer, chest, MONDAY, THURSDAY));
+    CHECK(twoDayScore(optimizer, quads, TUESDAY, SUNDAY) < twoDayScore(optimizer, quads, TUESDAY, FRIDAY));
+}
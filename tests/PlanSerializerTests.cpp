@@ -0,0 +1,137 @@
+#include "Check.h"
+#include "PlanSerializer.h"
+#include "WorkoutPlanner.h"
+#include "PlanContext.h"
+#include "User.h"
+#include <cstring>
+
+static const double WEIGHT = 82;
+
+static vector<WorkoutSession> bundledPlan(const shared_ptr<const ExerciseCatalog>& catalog, uint64_t seed) {
+    WorkoutPlanner planner(catalog);
+    User user("Test", 180, (int)WEIGHT, 30, "Male", dayBit(MONDAY) | dayBit(WEDNESDAY) | dayBit(SATURDAY),
+              {"Barbell", "Dumbbells", "Bench", "Cable Machine"},
+              {{"Chest", Priority::HIGH}, {"Legs", Priority::MEDIUM}}, Goal::STRENGTH);
+    PlanContext ctx(user, seed);
+    return planner.makePlan(ctx);
+}
+
+//same sessions, compared through everything the session works out again after reading
+static bool samePlan(span<const WorkoutSession> a, span<const WorkoutSession> b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); i++) {
+        if (a[i].getDay() != b[i].getDay() || a[i].getSessionType() != b[i].getSessionType() ||
+            a[i].getSessionName() != b[i].getSessionName() || a[i].getDuration() != b[i].getDuration() ||
+            a[i].getCaloriesBurned() != b[i].getCaloriesBurned() || a[i].getMuscleMask() != b[i].getMuscleMask()) {
+            return false;
+        }
+        span<const PlannedExercise> x = a[i].getExercises(), y = b[i].getExercises();
+        if (x.size() != y.size()) return false;
+        for (size_t e = 0; e < x.size(); e++) {
+            if (x[e].index != y[e].index || x[e].duration != y[e].duration) return false;
+        }
+    }
+    return true;
+}
+
+TEST(binaryPlanRoundTrip) {
+    auto catalog = ExerciseCatalog::load("exercise_database.json");
+    CHECK(catalog != nullptr);
+    if (!catalog) return;
+    for (uint64_t seed : {1, 2, 3}) {
+        vector<WorkoutSession> plan = bundledPlan(catalog, seed);
+        CHECK(!plan.empty());
+        string data;
+        CHECK(writePlanBinary(plan, data));
+
+        vector<WorkoutSession> read;
+        CHECK(readPlanBinary(data, catalog, WEIGHT, read));
+        CHECK(samePlan(plan, read));
+
+        string again;
+        CHECK(writePlanBinary(read, again));
+        CHECK(again == data);
+    }
+
+    vector<WorkoutSession> empty, read;
+    string data;
+    CHECK(writePlanBinary(empty, data));
+    CHECK(readPlanBinary(data, catalog, WEIGHT, read) && read.empty());
+}
+
+//nothing is read from a damaged plan and the output is left as it was
+TEST(binaryPlanRejectsDamage) {
+    auto catalog = ExerciseCatalog::load("exercise_database.json");
+    if (!catalog) return;
+    vector<WorkoutSession> plan = bundledPlan(catalog, 5);
+    string data;
+    CHECK(writePlanBinary(plan, data));
+
+    //every cut short version, only the full data is a plan
+    for (size_t length = 0; length < data.size(); length++) {
+        vector<WorkoutSession> read = plan;
+        CHECK(!readPlanBinary(string_view(data).substr(0, length), catalog, WEIGHT, read));
+        CHECK(samePlan(read, plan));
+    }
+
+    auto damaged = [&](size_t offset, auto value) {
+        string copy = data;
+        memcpy(copy.data() + offset, &value, sizeof(value));
+        vector<WorkoutSession> read;
+        return !readPlanBinary(copy, catalog, WEIGHT, read);
+    };
+    const size_t header = sizeof(PLAN_MAGIC) + 3 * sizeof(uint32_t);
+    CHECK(damaged(0, 'X'));                                             //magic
+    CHECK(damaged(sizeof(PLAN_MAGIC), PLAN_VERSION + 1));              //version
+    CHECK(damaged(sizeof(PLAN_MAGIC) + 4, uint32_t(catalog->size() + 1)));   //another catalog
+    CHECK(damaged(header, uint8_t(DAYS_IN_WEEK)));                     //first session's day
+    CHECK(damaged(header + 1, uint8_t(200)));                          //its type
+    size_t firstExercise = header + 6 + plan[0].getSessionName().size();
+    CHECK(damaged(firstExercise, uint32_t(catalog->size())));          //exercise past the catalog
+
+    vector<WorkoutSession> read;
+    CHECK(!readPlanBinary(data, nullptr, WEIGHT, read));
+}
+
+//the same bytes on every machine, lowest byte first
+TEST(binaryPlanIsLittleEndian) {
+    auto catalog = ExerciseCatalog::load("exercise_database.json");
+    if (!catalog) return;
+    vector<WorkoutSession> plan = bundledPlan(catalog, 1);
+    string data;
+    CHECK(writePlanBinary(plan, data));
+    const size_t header = sizeof(PLAN_MAGIC) + 3 * sizeof(uint32_t);
+    CHECK(data.size() > header);
+    if (data.size() <= header) return;
+    auto byte = [&](size_t at) { return (unsigned)(unsigned char)data[at]; };
+    CHECK(byte(8) == 1 && byte(9) == 0 && byte(10) == 0 && byte(11) == 0);
+    CHECK(byte(12) == (catalog->size() & 0xff) && byte(13) == (catalog->size() >> 8 & 0xff));
+    CHECK(byte(16) == plan.size() && byte(17) == 0);
+    size_t nameLength = plan[0].getSessionName().size();
+    CHECK(byte(header + 2) == (nameLength & 0xff) && byte(header + 3) == nameLength >> 8);
+    uint32_t index = plan[0].getExercises()[0].index;
+    size_t firstExercise = header + 6 + nameLength;
+    CHECK(byte(firstExercise) == (index & 0xff) && byte(firstExercise + 1) == (index >> 8 & 0xff));
+}
+
+//counts and minutes that don't fit their field fail the write instead of being cut short
+TEST(binaryPlanRejectsOversized) {
+    auto catalog = ExerciseCatalog::load("exercise_database.json");
+    if (!catalog) return;
+    vector<WorkoutSession> longName;
+    longName.emplace_back(MONDAY, catalog, vector<PlannedExercise>{{0, 10}}, SessionType::FULL_BODY, WEIGHT,
+                          string(UINT16_MAX + 1, 'x'));
+    vector<WorkoutSession> longExercise;
+    longExercise.emplace_back(MONDAY, catalog, vector<PlannedExercise>{{0, UINT16_MAX + 1}}, SessionType::FULL_BODY,
+                              WEIGHT, "Full Body");
+    vector<WorkoutSession> manyExercises;
+    manyExercises.emplace_back(MONDAY, catalog, vector<PlannedExercise>(UINT16_MAX + 1, {0, 1}),
+                               SessionType::FULL_BODY, WEIGHT, "Full Body");
+
+    for (const vector<WorkoutSession>& plan : {longName, longExercise, manyExercises}) {
+        string data = "kept";
+        CHECK(!writePlanBinary(plan, data));
+        CHECK(!writePlan(plan, PlanFormat::BINARY, data));
+        CHECK(data == "kept");
+    }
+}
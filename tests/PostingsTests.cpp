@@ -0,0 +1,78 @@
+#include "Check.h"
+#include "Postings.h"
+#include <algorithm>
+#include <random>
+#include <iterator>
+
+//up to count distinct indices below limit, sorted
+static PostingList randomList(mt19937& rng, size_t count, uint32_t limit) {
+    PostingList list;
+    uniform_int_distribution<uint32_t> pick(0, limit - 1);
+    for (size_t i = 0; i < count; i++) {
+        list.push_back(pick(rng));
+    }
+    sort(list.begin(), list.end());
+    list.erase(unique(list.begin(), list.end()), list.end());
+    return list;
+}
+
+static PostingList expectedIntersection(const PostingList& a, const PostingList& b) {
+    PostingList result;
+    set_intersection(a.begin(), a.end(), b.begin(), b.end(), back_inserter(result));
+    return result;
+}
+
+//sizes on both sides of the gallop ratio, both argument orders
+TEST(postingsIntersectMatchesSetIntersection) {
+    mt19937 rng(13);
+    const size_t sizes[] = {0, 1, 2, 7, 15, 16, 17, 100, 1000, 20000};
+    for (size_t small : sizes) {
+        for (size_t large : sizes) {
+            for (uint32_t limit : {50u, 5000u, 100000u}) {
+                PostingList a = randomList(rng, small, limit);
+                PostingList b = randomList(rng, large, limit);
+                PostingList expected = expectedIntersection(a, b);
+                CHECK(intersectPostings(a, b) == expected);
+                CHECK(intersectPostings(b, a) == expected);
+            }
+        }
+    }
+}
+
+//matches sitting at the very start and end of the long list, where the gallop steps past the end
+TEST(postingsIntersectEdges) {
+    PostingList large(4096);
+    for (uint32_t i = 0; i < large.size(); i++) {
+        large[i] = i * 2;
+    }
+    for (PostingList small : {PostingList{0}, PostingList{8190}, PostingList{0, 8190}, PostingList{8191},
+                              PostingList{1, 3, 8192}, PostingList{4094, 4095, 4096}}) {
+        CHECK(intersectPostings(small, large) == expectedIntersection(small, large));
+    }
+}
+
+TEST(postingsUnionMatchesSetUnion) {
+    mt19937 rng(31);
+    for (int round = 0; round < 50; round++) {
+        vector<PostingList> lists;
+        for (size_t count = round % 6; count > 0; count--) {
+            lists.push_back(randomList(rng, rng() % 300, 1000));
+        }
+        PostingList expected;
+        vector<const PostingList*> pointers;
+        for (const PostingList& list : lists) {
+            PostingList merged;
+            set_union(expected.begin(), expected.end(), list.begin(), list.end(), back_inserter(merged));
+            expected = move(merged);
+            pointers.push_back(&list);
+        }
+        CHECK(unionPostings(pointers) == expected);
+        pmr::vector<uint32_t> scratch = unionPostings(span<const PostingList* const>(pointers), pmr::get_default_resource());
+        CHECK(equal(scratch.begin(), scratch.end(), expected.begin(), expected.end()));
+        if (lists.size() >= 2) {
+            PostingList two;
+            set_union(lists[0].begin(), lists[0].end(), lists[1].begin(), lists[1].end(), back_inserter(two));
+            CHECK(unionPostings(lists[0], lists[1]) == two);
+        }
+    }
+}
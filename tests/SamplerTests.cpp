@@ -0,0 +1,96 @@
+#include "Check.h"
+#include "Sampler.h"
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+#include <map>
+
+static vector<uint32_t> itemsUpTo(uint32_t count) {
+    vector<uint32_t> items(count);
+    iota(items.begin(), items.end(), 100);
+    return items;
+}
+
+//true if count is within tolerance of expected, as a fraction of expected
+static bool near(int count, double expected, double tolerance = 0.05) {
+    return fabs(count - expected) <= expected * tolerance;
+}
+
+//drawing until the sampler runs out gives every item once and leaves the list alone
+TEST(samplerDrawsEveryItemOnce) {
+    mt19937 rng(15);
+    for (uint32_t count : {0u, 1u, 2u, 5u, 64u, 1000u}) {
+        vector<uint32_t> items = itemsUpTo(count);
+        vector<uint32_t> original = items;
+        Sampler sampler(items);
+        vector<uint32_t> drawn;
+        uint32_t item;
+        while (sampler.next(rng, item)) {
+            drawn.push_back(item);
+        }
+        CHECK(sampler.remaining() == 0);
+        CHECK(!sampler.next(rng, item));
+        sort(drawn.begin(), drawn.end());
+        CHECK(drawn == original);
+        CHECK(items == original);
+    }
+}
+
+//every order of three items comes up about as often
+TEST(samplerOrdersAreUniform) {
+    mt19937 rng(51);
+    vector<uint32_t> items = itemsUpTo(3);
+    map<vector<uint32_t>, int> orders;
+    const int trials = 60000;
+    for (int t = 0; t < trials; t++) {
+        Sampler sampler(items);
+        vector<uint32_t> order(3);
+        for (uint32_t& item : order) {
+            sampler.next(rng, item);
+        }
+        orders[order]++;
+    }
+    CHECK(orders.size() == 6);
+    for (const auto& [order, count] : orders) {
+        CHECK(near(count, trials / 6.0));
+    }
+}
+
+//the first weighted pick follows the weights, the later ones the weights of what is left
+TEST(samplerWeightedFollowsWeights) {
+    mt19937 rng(115);
+    vector<uint32_t> items = {0, 1, 2, 3};
+    auto weight = [](uint32_t item) { return item + 1.0; };
+    map<uint32_t, int> first, second;
+    const int trials = 100000;
+    for (int t = 0; t < trials; t++) {
+        Sampler sampler(items);
+        uint32_t a, b;
+        CHECK(sampler.next(rng, a, weight, 4.0));
+        CHECK(sampler.next(rng, b, weight, 4.0));
+        CHECK(a != b);
+        first[a]++;
+        if (a == 3) second[b]++;
+    }
+    for (uint32_t item : items) {
+        CHECK(near(first[item], trials * weight(item) / 10.0));
+    }
+    //after 3 is gone the weights are 1, 2 and 3
+    for (uint32_t item = 0; item < 3; item++) {
+        CHECK(near(second[item], first[3] * weight(item) / 6.0));
+    }
+}
+
+//items that are never accepted still come out, after the rejections the pick is uniform
+TEST(samplerWeightedZeroWeightsFallBack) {
+    mt19937 rng(150);
+    vector<uint32_t> items = itemsUpTo(10);
+    Sampler sampler(items);
+    vector<uint32_t> drawn;
+    uint32_t item;
+    while (sampler.next(rng, item, [](uint32_t) { return 0.0; }, 1.0)) {
+        drawn.push_back(item);
+    }
+    sort(drawn.begin(), drawn.end());
+    CHECK(drawn == items);
+}
@@ -0,0 +1,90 @@
+#include "Check.h"
+#include "SessionPacker.h"
+#include <random>
+#include <climits>
+#include <span>
+
+struct PackResult {
+    int minutes = 0;
+    int value = 0;
+};
+
+static PackResult totalOf(span<const PackItem> items, span<const size_t> chosen) {
+    PackResult total;
+    for (size_t pos : chosen) {
+        total.minutes += items[pos].minutes;
+        total.value += items[pos].value;
+    }
+    return total;
+}
+
+//Every subset tried. Best value inside the window, or when nothing fits it the longest total
+//under maxTime, which is what packSession promises.
+static PackResult bruteForce(span<const PackItem> items, int minTime, int maxTime, bool& inWindow) {
+    PackResult best{-1, INT_MIN};
+    inWindow = false;
+    for (uint32_t subset = 0; subset < (1u << items.size()); subset++) {
+        PackResult total;
+        bool usable = true;
+        for (size_t i = 0; i < items.size(); i++) {
+            if (!(subset >> i & 1)) continue;
+            if (items[i].minutes <= 0) usable = false;
+            total.minutes += items[i].minutes;
+            total.value += items[i].value;
+        }
+        if (!usable || total.minutes > maxTime) continue;
+        if (total.minutes >= minTime) {
+            if (!inWindow || total.value > best.value) best = total;
+            inWindow = true;
+        } else if (!inWindow && total.minutes > best.minutes) {
+            best = total;
+        }
+    }
+    return best;
+}
+
+TEST(packerMatchesBruteForce) {
+    mt19937 rng(16);
+    for (int round = 0; round < 400; round++) {
+        vector<PackItem> items(rng() % 13);
+        for (size_t i = 0; i < items.size(); i++) {
+            //mostly normal exercises, now and then one that is too long, empty or only fills time
+            int minutes = rng() % 20 == 0 ? 0 : 3 + rng() % (round % 4 == 0 ? 120 : 25);
+            int value = rng() % 6 == 0 ? -(int)(rng() % 10) : rng() % 30;
+            items[i] = {(uint32_t)i, minutes, value};
+        }
+        int minTime = rng() % 90;
+        int maxTime = minTime + rng() % 40;
+
+        bool inWindow;
+        PackResult expected = bruteForce(items, minTime, maxTime, inWindow);
+        pmr::vector<size_t> chosen = packSession(items, minTime, maxTime);
+        PackResult got = totalOf(items, chosen);
+
+        for (size_t i = 1; i < chosen.size(); i++) {
+            CHECK(chosen[i - 1] < chosen[i]);
+        }
+        if (inWindow) {
+            CHECK(got.minutes >= minTime && got.minutes <= maxTime);
+            CHECK(got.value == expected.value);
+        } else {
+            CHECK(got.minutes == expected.minutes);
+        }
+    }
+}
+
+//only the first MAX_PACK_ITEMS are candidates and the window is capped at MAX_SESSION_MINUTES
+TEST(packerLimits) {
+    vector<PackItem> items;
+    for (uint32_t i = 0; i < MAX_PACK_ITEMS + 8; i++) {
+        items.push_back({i, 5, i < MAX_PACK_ITEMS ? 1 : 100});
+    }
+    pmr::vector<size_t> chosen = packSession(items, 0, 1000);
+    CHECK(chosen.size() == MAX_PACK_ITEMS);
+    for (size_t pos : chosen) {
+        CHECK(pos < MAX_PACK_ITEMS);
+    }
+
+    vector<PackItem> longItems(MAX_PACK_ITEMS, {0, 20, 1});
+    CHECK(totalOf(longItems, packSession(longItems, 0, 1000)).minutes <= MAX_SESSION_MINUTES);
+}
@@ -0,0 +1,139 @@
+#include "Check.h"
+#include "CatalogSnapshot.h"
+#include "ExerciseCatalog.h"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <cstring>
+#include <cstddef>
+#include <algorithm>
+
+static string snapshotPath(const string& name) {
+    return (filesystem::temp_directory_path() / ("swp_test_" + name)).string();
+}
+
+static string readFile(const string& path) {
+    ifstream file(path, ios::binary);
+    stringstream text;
+    text << file.rdbuf();
+    return text.str();
+}
+
+//snapshot of the bundled database, written once and copied by the tests that damage it
+static const string& bundledSnapshot() {
+    static const string path = [] {
+        string out = snapshotPath("catalog.bin");
+        auto catalog = ExerciseCatalog::load("exercise_database.json");
+        if (!catalog || !saveSnapshot(*catalog, out)) return string();
+        return out;
+    }();
+    return path;
+}
+
+//the bundled snapshot with the header changed before it is written back
+template <typename Change>
+static string damagedSnapshot(const string& name, Change change) {
+    string bytes = readFile(bundledSnapshot());
+    SnapshotHeader header;
+    memcpy(&header, bytes.data(), sizeof(header));
+    change(header, bytes);
+    memcpy(bytes.data(), &header, sizeof(header));
+    return writeTempFile(name, bytes);
+}
+
+TEST(snapshotRoundTripMatchesJson) {
+    auto json = ExerciseCatalog::load("exercise_database.json");
+    CHECK(json != nullptr && !bundledSnapshot().empty());
+    if (!json || bundledSnapshot().empty()) return;
+    auto snapshot = loadSnapshot(bundledSnapshot());
+    CHECK(snapshot != nullptr);
+    if (!snapshot) return;
+
+    CHECK(snapshot->size() == json->size());
+    for (size_t i = 0; i < json->size() && i < snapshot->size(); i++) {
+        ExerciseView a = json->view(i), b = snapshot->view(i);
+        CHECK(a.name() == b.name());
+        CHECK(a.equipment() == b.equipment());
+        CHECK(json->getStore().text(a.get().categoryRef) == snapshot->getStore().text(b.get().categoryRef));
+        CHECK(a.get().muscleMask == b.get().muscleMask);
+        CHECK(a.get().isCompound == b.get().isCompound);
+        CHECK(a.get().estimatedDurationMinutes == b.get().estimatedDurationMinutes);
+        CHECK(ranges::equal(a.get().listedMuscles(), b.get().listedMuscles()));
+        CHECK(ranges::equal(a.equipmentOptions(), b.equipmentOptions()));
+    }
+
+    const EquipmentVocab& vocab = json->getEquipmentVocab();
+    CHECK(snapshot->getEquipmentVocab().size() == vocab.size());
+    for (size_t id = 0; id < vocab.size(); id++) {
+        CHECK(snapshot->getEquipmentVocab().name(id) == vocab.name(id));
+    }
+}
+
+//records and text sit in the mapping the same distance apart as in the file, nothing was copied
+TEST(snapshotReadsRecordsInPlace) {
+    if (bundledSnapshot().empty()) return;
+    auto snapshot = loadSnapshot(bundledSnapshot());
+    CHECK(snapshot != nullptr);
+    if (!snapshot) return;
+
+    SnapshotHeader header;
+    memcpy(&header, readFile(bundledSnapshot()).data(), sizeof(header));
+    const char* records = (const char*)snapshot->getExercises().data();
+    const char* text = snapshot->getStore().textData().data();
+    CHECK(text - records == (ptrdiff_t)(header.textOffset - header.recordOffset));
+}
+
+TEST(snapshotRejectsOtherMachines) {
+    if (bundledSnapshot().empty()) return;
+    string swapped = damagedSnapshot("byteorder.bin", [](SnapshotHeader& header, string&) {
+        header.byteOrder = __builtin_bswap32(header.byteOrder);
+    });
+    CHECK(loadSnapshot(swapped) == nullptr);
+
+    string layout = damagedSnapshot("recordsize.bin", [](SnapshotHeader& header, string&) {
+        header.recordSize += 4;
+    });
+    CHECK(loadSnapshot(layout) == nullptr);
+}
+
+TEST(snapshotRejectsDamage) {
+    if (bundledSnapshot().empty()) return;
+    string truncated = damagedSnapshot("truncated.bin", [](SnapshotHeader& header, string& bytes) {
+        bytes.resize(header.textOffset + header.textSize / 2);
+    });
+    CHECK(loadSnapshot(truncated) == nullptr);
+
+    //the first record's name pointing past the text
+    string badName = damagedSnapshot("badname.bin", [](SnapshotHeader& header, string& bytes) {
+        uint32_t ref = header.textSize;
+        memcpy(bytes.data() + header.recordOffset + offsetof(Exercise, nameRef), &ref, sizeof(ref));
+    });
+    CHECK(loadSnapshot(badName) == nullptr);
+
+    string badMuscle = damagedSnapshot("badmuscle.bin", [](SnapshotHeader& header, string& bytes) {
+        uint8_t id = header.muscleCount;
+        memcpy(bytes.data() + header.recordOffset + offsetof(Exercise, muscleIds), &id, sizeof(id));
+    });
+    CHECK(loadSnapshot(badMuscle) == nullptr);
+}
+
+//a snapshot that gets turned away must not have put its muscle names into the shared table
+TEST(snapshotRejectedLeavesMusclesAlone) {
+    if (bundledSnapshot().empty()) return;
+    string unknown;
+    string corrupt = damagedSnapshot("newmuscle.bin", [&](SnapshotHeader& header, string& bytes) {
+        SnapshotString last;
+        memcpy(&last, bytes.data() + header.muscleOffset + (header.muscleCount - 1) * sizeof(SnapshotString),
+               sizeof(last));
+        unknown = string(last.length, 'Q');
+        memcpy(bytes.data() + header.namePoolOffset + last.offset, unknown.data(), last.length);
+
+        uint8_t id = header.muscleCount;
+        memcpy(bytes.data() + header.recordOffset + offsetof(Exercise, muscleIds), &id, sizeof(id));
+    });
+    vector<string> before = muscleNames(~MuscleMask(0));
+    CHECK(muscleId(unknown) == -1);
+    CHECK(loadSnapshot(corrupt) == nullptr);
+    CHECK(muscleId(unknown) == -1);
+    CHECK(muscleNames(~MuscleMask(0)) == before);
+}
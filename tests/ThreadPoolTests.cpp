@@ -0,0 +1,47 @@
+#include "Check.h"
+#include "ThreadPool.h"
+#include "WorkoutPlanner.h"
+#include <atomic>
+#include <future>
+#include <latch>
+
+//tasks submitted from outside and from workers all run before the pool is gone
+TEST(threadPoolRunsEveryTask) {
+    atomic<int> ran{0};
+    {
+        ThreadPool pool(4);
+        vector<thread> submitters;
+        for (int t = 0; t < 4; t++) {
+            submitters.emplace_back([&] {
+                for (int i = 0; i < 2000; i++) {
+                    pool.submit([&] {
+                        ran++;
+                        if (ran % 7 == 0) pool.submit([&] { ran++; });
+                    });
+                }
+            });
+        }
+        for (thread& submitter : submitters) submitter.join();
+    }
+    CHECK(ran >= 8000);
+    CHECK(!ThreadPool(1).onWorker());
+}
+
+//with one worker, a task that waited on the pool for the batch would never finish
+TEST(threadPoolNestedBatchRunsInline) {
+    WorkoutPlanner planner;
+    CHECK(planner.loadData(writeTempFile("pool.json",
+        "[{\"exercise\":\"Squat\",\"muscle_groups\":[\"Quads\"],\"equipment\":\"Barbell\"},"
+        "{\"exercise\":\"Push Up\",\"muscle_groups\":[\"Chest\"],\"equipment\":\"Bodyweight\"}]")));
+    vector<User> users(3, User("x", 170, 70, 25, "Male", dayBit(MONDAY), {"Free Weights"}, {{"Chest", Priority::HIGH}}, Goal::STRENGTH));
+
+    ThreadPool pool(1);
+    promise<size_t> planned;
+    pool.submit([&] {
+        CHECK(pool.onWorker());
+        planned.set_value(planner.makePlans(users, pool).size());
+    });
+    future<size_t> result = planned.get_future();
+    CHECK(result.wait_for(chrono::seconds(10)) == future_status::ready);
+    if (result.valid()) CHECK(result.get() == users.size());
+}
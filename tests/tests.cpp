@@ -0,0 +1,58 @@
+//Runs every registered check, or only the ones whose name contains the first argument
+#include "Check.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+struct RegisteredTest {
+    const char* name;
+    function<void()> body;
+};
+
+static vector<RegisteredTest>& registry() {
+    static vector<RegisteredTest> tests;
+    return tests;
+}
+
+static int failures = 0;
+
+TestCase::TestCase(const char* name, function<void()> body) {
+    registry().push_back({name, move(body)});
+}
+
+void checkFailed(const char* file, int line, const char* condition) {
+    printf("  FAILED %s:%d: %s\n", file, line, condition);
+    failures++;
+}
+
+string writeTempFile(const string& name, const string& text) {
+    string path = (filesystem::temp_directory_path() / ("swp_test_" + name)).string();
+    ofstream(path, ios::binary | ios::trunc) << text;
+    return path;
+}
+
+int main(int argc, char* argv[]) {
+    string filter = argc > 1 ? argv[1] : "";
+    int run = 0, failed = 0;
+
+    //the loaders print progress and some checks expect errors, only the results go to stdout
+    ofstream sink;
+    streambuf* savedOut = cout.rdbuf(sink.rdbuf());
+    streambuf* savedErr = cerr.rdbuf(sink.rdbuf());
+
+    for (const RegisteredTest& test : registry()) {
+        if (string(test.name).find(filter) == string::npos) continue;
+        int before = failures;
+        printf("%s\n", test.name);
+        test.body();
+        run++;
+        if (failures != before) failed++;
+    }
+
+    cout.rdbuf(savedOut);
+    cerr.rdbuf(savedErr);
+    printf("\n%d tests, %d failed\n", run, failed);
+    return failed == 0 ? 0 : 1;
+}